@@ -1,23 +1,50 @@
 #ifndef ADJACENTLIST_H
 #define ADJACENTLIST_H
 
+#include <unordered_map>
+
 #include "set.h"
+#include "listnode.h"
 
-template<class C, class Compare = std::equal_to<C>> class AdjacentList
+// Adjacency list of one vertex. The neighbour set is hashed when a
+// Hash is supplied, which makes edge insertion and lookups O(1).
+// AdjacentSet can be any set type with the Set interface, e.g. a
+// FlatSet to keep the neighbours sorted.
+//
+// incoming holds the vertices with an edge to this one, so a graph can
+// tell whether a vertex is referenced and drop its incoming edges without
+// scanning every other adjacency list.
+//
+// weights holds the weights of the outgoing edges that were given one,
+// keyed by the graph's own object of the target vertex. Every other edge
+// weighs 1, so unweighted graphs never allocate for it.
+template<class C, class Compare = std::equal_to<C>, class Hash = NoHash<C>, class AdjacentSet = Set<C, Compare, Hash>> class AdjacentList
 {
 public:
     C* vertex;
-    Set<C, Compare> adjacent;
+    AdjacentSet adjacent;
+    AdjacentSet incoming;
+    std::unordered_map<const C*, double> weights;
+
+    // Node of the previous vertex in the graph's vertex list (nullptr for
+    // the first), kept by Graph so a vertex can be unlinked in O(1)
+    ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>* previous;
     
     // Default constructor
-    AdjacentList() : vertex(nullptr), adjacent() {
+    AdjacentList() : vertex(nullptr), adjacent(), incoming(), weights(), previous(nullptr) {
         
     }
     
     // Constructor with Compare object
-    AdjacentList(const Compare& comp) : vertex(nullptr), adjacent(comp) {
+    AdjacentList(const Compare& comp) : vertex(nullptr), adjacent(comp), incoming(comp), weights(), previous(nullptr) {
         
     }
+
+    // Weight of the edge to target, given as the graph's object of it
+    double getWeight(const C* target) const {
+        auto found = this->weights.find(target);
+        return found == this->weights.end() ? 1.0 : found->second;
+    }
     
     ~AdjacentList() {
         // The vertex is not owned by the adjacent list
@@ -7,10 +7,13 @@
 #include "graph.h"
 #include "bfsvertex.h"
 #include "set.h"
+#include "csrgraph.h"
+#include "traversalstate.h"
 #include <type_traits>
+#include <vector>
 
-template<typename T, typename Compare = std::equal_to<T>> 
-int bfs(Graph<T, Compare>* graph, 
+template<typename T, typename Compare = std::equal_to<T>, typename Hash = NoHash<T>, typename AdjacentSet = Set<T, Compare, Hash>>
+int bfs(Graph<T, Compare, Hash, AdjacentSet>* graph, 
         T* start, 
         List<T>& hops) {
                   
@@ -18,15 +21,18 @@ int bfs(Graph<T, Compare>* graph,
         return -1; // Invalid parameters
     }
 
-    Queue<AdjacentList<T, Compare>> queue;
+    Queue<AdjacentList<T, Compare, Hash, AdjacentSet>> queue;
 
-    AdjacentList<T, Compare>* adjList = nullptr;
-    AdjacentList<T, Compare>* clrAdjList;
+    // Every vertex is enqueued at most once, so the queue never has to grow
+    queue.reserve(graph->getVertexCount());
+
+    AdjacentList<T, Compare, Hash, AdjacentSet>* adjList = nullptr;
+    AdjacentList<T, Compare, Hash, AdjacentSet>* clrAdjList;
 
     T* clrVertex;
     T* adjVertex;
 
-    ListNode<AdjacentList<T, Compare>>* node;
+    ListNode<AdjacentList<T, Compare, Hash, AdjacentSet>>* node;
 
     // Initialize all vertices
     for (node = graph->getAdjacencyListHead(); node != nullptr; node = node->next()) {
@@ -80,7 +86,144 @@ int bfs(Graph<T, Compare>* graph,
         clrVertex = node->data()->vertex;
 
         if (clrVertex->getHops() != -1) {
-            hops.insert(hops.tail(), clrVertex);
+            hops.insertUnchecked(hops.tail(), clrVertex);
+        }
+    }
+
+    return 0;
+}
+
+// How bfs on a CSR snapshot expands each level
+typedef enum BfsMode_ {
+    BfsTopDown,             // Every frontier vertex scans its out-edges
+    BfsDirectionOptimizing  // Switch to bottom-up steps while the frontier is large
+} BfsMode;
+
+// Direction switching thresholds (Beamer et al.): go bottom-up when the
+// frontier's out-edges exceed 1/alpha of the in-edges of the unvisited
+// vertices, back to top-down once a shrinking frontier holds fewer than
+// 1/beta of the vertices
+static const uint64_t bfsAlpha = 14;
+static const uint64_t bfsBeta = 24;
+
+// Breadth-first search over a CSR snapshot from the vertex with ID source,
+// recording hops and discovery order in state instead of the vertex
+// objects. The graph is only read, so searches with separate states can run
+// on the same snapshot concurrently, and the vertices need not be BfsVertex.
+// Reusing a state skips clearing it, so a top-down search costs time in
+// proportion to the part of the graph it reaches.
+//
+// The search runs level by level, each level being a contiguous run of
+// state.reached. In a bottom-up step every unvisited vertex scans its
+// in-neighbours for one in the frontier and stops at the first, which on
+// low-diameter graphs examines far fewer edges than the top-down step once
+// the frontier covers a large part of the graph. Both steps assign the same
+// hops, so the mode only changes the running time.
+template<typename T>
+int bfs(const CsrGraph<T>* graph,
+        uint32_t source,
+        BfsState& state,
+        BfsMode mode = BfsTopDown) {
+
+    if (!graph || source >= static_cast<uint32_t>(graph->getVertexCount())) {
+        return -1; // Invalid parameters
+    }
+
+    // A vertex is in the current frontier when its hops equal level
+    uint32_t vertexCount = static_cast<uint32_t>(graph->getVertexCount());
+    std::vector<uint32_t>& reached = state.reached;
+    state.reset(vertexCount);
+    state.reach(source, 0);
+
+    uint64_t frontierEdges = graph->degree(source);
+    uint64_t unvisitedEdges = static_cast<uint64_t>(graph->getEdgeCount()) - graph->inDegree(source);
+    size_t frontierBegin = 0;
+    size_t previousSize = 0;
+    bool bottomUp = false;
+
+    for (int level = 0; frontierBegin < reached.size(); level++) {
+        size_t frontierEnd = reached.size();
+        size_t frontierSize = frontierEnd - frontierBegin;
+
+        if (mode == BfsDirectionOptimizing) {
+            if (!bottomUp) {
+                bottomUp = frontierEdges * bfsAlpha > unvisitedEdges;
+            } else {
+                bottomUp = !(frontierSize < previousSize && frontierSize * bfsBeta < vertexCount);
+            }
+        }
+
+        frontierEdges = 0;
+
+        // The frontier is read by index, as reaching vertices appends to it
+        if (!bottomUp) {
+            for (size_t i = frontierBegin; i < frontierEnd; i++) {
+                uint32_t current = reached[i];
+
+                for (const uint32_t* adj = graph->adjacentBegin(current); adj != graph->adjacentEnd(current); adj++) {
+                    if (!state.isReached(*adj)) {
+                        state.reach(*adj, level + 1);
+                        frontierEdges += graph->degree(*adj);
+                        unvisitedEdges -= graph->inDegree(*adj);
+                    }
+                }
+            }
+        } else {
+            for (uint32_t id = 0; id < vertexCount; id++) {
+                if (state.isReached(id)) {
+                    continue;
+                }
+
+                for (const uint32_t* parent = graph->incomingBegin(id); parent != graph->incomingEnd(id); parent++) {
+                    if (state.getHops(*parent) == level) {
+                        state.reach(id, level + 1);
+                        frontierEdges += graph->degree(id);
+                        unvisitedEdges -= graph->inDegree(id);
+                        break;
+                    }
+                }
+            }
+        }
+
+        previousSize = frontierSize;
+        frontierBegin = frontierEnd;
+    }
+
+    return 0;
+}
+
+// Breadth-first search over a CSR snapshot. Gives the same colors, hops
+// and hop list as bfs on the graph the snapshot was taken from, but keeps
+// the search state in arrays indexed by vertex ID and only writes it to the
+// vertex objects once at the end. start must be one of the graph's vertex
+// objects.
+template<typename T>
+int bfs(const CsrGraph<T>* graph,
+        T* start,
+        List<T>& hops,
+        BfsMode mode = BfsTopDown) {
+
+    if (!graph || !start) {
+        return -1; // Invalid parameters
+    }
+
+    uint32_t source = graph->idOf(start);
+    if (source == CsrGraph<T>::noVertex) {
+        return -1;  // Starting vertex not found
+    }
+
+    BfsState state;
+    bfs(graph, source, state, mode);
+
+    hops.clear();
+
+    for (uint32_t id = 0; id < state.marks.size(); id++) {
+        T* vertex = graph->vertex(id);
+        vertex->setHops(state.getHops(id));
+        vertex->setColor(state.getColor(id));
+
+        if (state.getHops(id) != -1) {
+            hops.insertUnchecked(hops.tail(), vertex);
         }
     }
 
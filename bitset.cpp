@@ -1,4 +1,4 @@
-#include "owneddatanode.h"
+#include "bitset.h"
 
 // This file is mostly empty because template implementations
 // must be in the header file.
@@ -0,0 +1,360 @@
+#ifndef BITSET_H
+#define BITSET_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "collection.h"
+
+/**
+ * @struct IntegerKey
+ * @brief Default key of a BitSet: the element's own value
+ *
+ * Works for any integral element type. Negative values convert to keys
+ * beyond BitSet's range, so a BitSet ignores them.
+ */
+template<class C> struct IntegerKey
+{
+    size_t operator()(const C& value) const {
+        return static_cast<size_t>(value);
+    }
+};
+
+template<class C> class BitSetNode;
+
+/**
+ * @struct BitSetStorage
+ * @brief Membership bits and element slots of a BitSet
+ *
+ * Bit k of the words is set when slot k holds a member. The nodes keep a
+ * pointer to the storage so they can find the next member themselves.
+ */
+template<class C> struct BitSetStorage
+{
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    uint64_t* words;          // Membership bits, 64 keys per word
+    BitSetNode<C>* elements;  // One slot per key, holding the member with that key
+    size_t wordCount;         // Number of words; there are wordCount * 64 slots
+
+    bool test(size_t key) const {
+        return key < this->wordCount * 64 && (this->words[key / 64] >> (key % 64)) & 1;
+    }
+
+    // Smallest member key at or after key, or npos
+    size_t nextMember(size_t key) const {
+        size_t w = key / 64;
+        if (w >= this->wordCount) {
+            return npos;
+        }
+
+        uint64_t bits = this->words[w] & (~uint64_t(0) << (key % 64));
+        while (bits == 0) {
+            if (++w == this->wordCount) {
+                return npos;
+            }
+            bits = this->words[w];
+        }
+        return w * 64 + __builtin_ctzll(bits);
+    }
+
+    // Largest member key, or npos when there are none
+    size_t lastMember() const {
+        for (size_t w = this->wordCount; w > 0; w--) {
+            if (this->words[w - 1] != 0) {
+                return (w - 1) * 64 + 63 - __builtin_clzll(this->words[w - 1]);
+            }
+        }
+        return npos;
+    }
+};
+
+/**
+ * @class BitSetNode
+ * @brief Slot of a BitSet, iterated the same way as a SetNode
+ *
+ * Iteration with next() visits the members in key order by scanning the
+ * membership bits, skipping 64 absent keys per word.
+ */
+template<class C> class BitSetNode
+{
+private:
+    C* data_field;
+    const BitSetStorage<C>* storage;
+
+    template<class, class> friend class BitSet;
+
+public:
+    BitSetNode() : data_field(nullptr), storage(nullptr) {
+    }
+
+    C* data() const {
+        return this->data_field;
+    }
+
+    // Member with the next larger key, or nullptr after the last one
+    BitSetNode<C>* next() const {
+        size_t key = this->storage->nextMember(static_cast<size_t>(this - this->storage->elements) + 1);
+        return key == BitSetStorage<C>::npos ? nullptr : &this->storage->elements[key];
+    }
+};
+
+/**
+ * @class BitSet
+ * @brief Set of element pointers over a dense domain of small integer keys
+ *
+ * Each element maps to an integer key with KeyOf, and the set keeps one
+ * membership bit and one element slot per key, so isMember, insert and
+ * remove are O(1). Union, intersection, difference, subset and equality
+ * work on whole 64-bit words in plain loops the compiler can vectorize.
+ * Two elements are the same member when their keys are equal.
+ *
+ * Memory is proportional to the largest key inserted, so keys should be
+ * small non-negative integers such as vertex numbers. The public interface
+ * and the static set operations mirror Set, so a BitSet can be used for
+ * frontier and visited sets and as the neighbour set of an AdjacentList.
+ * Null elements have no key and are ignored, and so are elements whose key
+ * is maxKey or more, such as negative integers: they are never members and
+ * inserting one leaves the set unchanged.
+ */
+template<class C, class KeyOf = IntegerKey<C>> class BitSet : public Collection<C>
+{
+private:
+    BitSetStorage<C> storage;
+    KeyOf keyOf;
+
+    // Key of data, or npos when it is out of range
+    size_t keyOfData(const C* data) const {
+        if (data == nullptr) {
+            return BitSetStorage<C>::npos;
+        }
+
+        size_t key = this->keyOf(*data);
+        return key < maxKey ? key : BitSetStorage<C>::npos;
+    }
+
+    // Make room for keys below wordCount * 64
+    void grow(size_t wordCount) {
+        if (wordCount <= this->storage.wordCount) {
+            return;
+        }
+
+        size_t newCount = this->storage.wordCount == 0 ? 1 : this->storage.wordCount;
+        while (newCount < wordCount) {
+            newCount *= 2;
+        }
+
+        uint64_t* newWords = new uint64_t[newCount]();
+        BitSetNode<C>* newElements = new BitSetNode<C>[newCount * 64];
+
+        for (size_t w = 0; w < this->storage.wordCount; w++) {
+            newWords[w] = this->storage.words[w];
+        }
+        for (size_t k = 0; k < newCount * 64; k++) {
+            if (k < this->storage.wordCount * 64) {
+                newElements[k].data_field = this->storage.elements[k].data_field;
+            }
+            newElements[k].storage = &this->storage;
+        }
+
+        delete[] this->storage.words;
+        delete[] this->storage.elements;
+        this->storage.words = newWords;
+        this->storage.elements = newElements;
+        this->storage.wordCount = newCount;
+    }
+
+    // Add the keys set in bits (word w) with the elements of the given sets,
+    // preferring first
+    void addWord(size_t w, uint64_t bits, const BitSet<C, KeyOf>* first, const BitSet<C, KeyOf>* second) {
+        bits &= ~this->storage.words[w];
+        this->storage.words[w] |= bits;
+        this->size += __builtin_popcountll(bits);
+
+        while (bits != 0) {
+            size_t key = w * 64 + __builtin_ctzll(bits);
+            const BitSet<C, KeyOf>* from = first->storage.test(key) ? first : second;
+            this->storage.elements[key].data_field = from->storage.elements[key].data_field;
+            bits &= bits - 1;
+        }
+    }
+
+    // Word w of a set, zero beyond its end
+    uint64_t word(size_t w) const {
+        return w < this->storage.wordCount ? this->storage.words[w] : 0;
+    }
+
+public:
+    // Keys must be below this, which keeps the slot arrays from overflowing
+    // size_t and puts every key cast from a negative integer out of range
+    static constexpr size_t maxKey = BitSetStorage<C>::npos / (4 * sizeof(BitSetNode<C>));
+
+    BitSet() : Collection<C>() {
+        this->storage.words = nullptr;
+        this->storage.elements = nullptr;
+        this->storage.wordCount = 0;
+    }
+
+    BitSet(const KeyOf& keyOf) : Collection<C>(), keyOf(keyOf) {
+        this->storage.words = nullptr;
+        this->storage.elements = nullptr;
+        this->storage.wordCount = 0;
+    }
+
+    ~BitSet() override {
+        // Owned elements are deleted by the Collection destructor
+        delete[] this->storage.words;
+        delete[] this->storage.elements;
+    }
+
+    // The nodes point back at the set, so it cannot be copied
+    BitSet(const BitSet&) = delete;
+    BitSet& operator=(const BitSet&) = delete;
+
+    // Get the size of the set
+    int getSize() const {
+        return this->size;
+    }
+
+    // Make room for keys below n so inserting them never reallocates
+    void reserve(size_t n) {
+        this->grow((n + 63) / 64);
+    }
+
+    // Number of keys the set can hold before it has to grow
+    size_t getCapacity() const {
+        return this->storage.wordCount * 64;
+    }
+
+    // Get the member with the smallest key, or nullptr when empty
+    BitSetNode<C>* head() const {
+        size_t key = this->storage.nextMember(0);
+        return key == BitSetStorage<C>::npos ? nullptr : &this->storage.elements[key];
+    }
+
+    // Get the member with the largest key, or nullptr when empty
+    BitSetNode<C>* tail() const {
+        size_t key = this->storage.lastMember();
+        return key == BitSetStorage<C>::npos ? nullptr : &this->storage.elements[key];
+    }
+
+    // Check if an element is in the set
+    bool isMember(const C* data) const {
+        size_t key = this->keyOfData(data);
+        return key != BitSetStorage<C>::npos && this->storage.test(key);
+    }
+
+    // Insert an element into the set if its key isn't already a member.
+    // Elements with an out-of-range key are not inserted, nor owned.
+    void insert(C* data, bool takeOwnership = false) {
+        size_t key = this->keyOfData(data);
+        if (key == BitSetStorage<C>::npos || this->storage.test(key)) {
+            return;
+        }
+
+        this->grow(key / 64 + 1);
+        this->storage.words[key / 64] |= uint64_t(1) << (key % 64);
+        this->storage.elements[key].data_field = data;
+
+        // Take ownership if requested
+        if (takeOwnership) {
+            this->takeOwnership(data);
+        }
+
+        this->size++;
+    }
+
+    // Remove the member with the same key as data
+    bool remove(C* data) {
+        size_t key = this->keyOfData(data);
+        if (key == BitSetStorage<C>::npos || !this->storage.test(key)) {
+            return false;
+        }
+
+        C* removed = this->storage.elements[key].data_field;
+        this->storage.words[key / 64] &= ~(uint64_t(1) << (key % 64));
+        this->storage.elements[key].data_field = nullptr;
+        this->size--;
+
+        // Release ownership if we owned the data
+        if (this->hasOwnership(removed)) {
+            this->releaseOwnership(removed);
+        }
+
+        return true;
+    }
+
+    // Set operations. Members already in result are kept, as with Set.
+    static void unionSet(BitSet<C, KeyOf>* result, const BitSet<C, KeyOf>* set1, const BitSet<C, KeyOf>* set2) {
+        size_t n1 = set1->storage.wordCount;
+        size_t n2 = set2->storage.wordCount;
+        result->grow(n1 > n2 ? n1 : n2);
+
+        for (size_t w = 0; w < result->storage.wordCount; w++) {
+            uint64_t bits = set1->word(w) | set2->word(w);
+            if (bits != 0) {
+                result->addWord(w, bits, set1, set2);
+            }
+        }
+    }
+
+    static void intersectionSet(BitSet<C, KeyOf>* result, const BitSet<C, KeyOf>* set1, const BitSet<C, KeyOf>* set2) {
+        size_t n1 = set1->storage.wordCount;
+        size_t n2 = set2->storage.wordCount;
+        size_t n = n1 < n2 ? n1 : n2;
+        result->grow(n);
+
+        for (size_t w = 0; w < n; w++) {
+            uint64_t bits = set1->storage.words[w] & set2->storage.words[w];
+            if (bits != 0) {
+                result->addWord(w, bits, set1, set1);
+            }
+        }
+    }
+
+    static void differenceSet(BitSet<C, KeyOf>* result, const BitSet<C, KeyOf>* set1, const BitSet<C, KeyOf>* set2) {
+        size_t n = set1->storage.wordCount;
+        result->grow(n);
+
+        for (size_t w = 0; w < n; w++) {
+            uint64_t bits = set1->storage.words[w] & ~set2->word(w);
+            if (bits != 0) {
+                result->addWord(w, bits, set1, set1);
+            }
+        }
+    }
+
+    static bool isSubset(const BitSet<C, KeyOf>* set1, const BitSet<C, KeyOf>* set2) {
+        // If set1 is larger than set2, it can't be a subset
+        if (set1->size > set2->size) {
+            return false;
+        }
+
+        size_t n1 = set1->storage.wordCount;
+        size_t n2 = set2->storage.wordCount;
+        size_t n = n1 < n2 ? n1 : n2;
+        const uint64_t* words1 = set1->storage.words;
+        const uint64_t* words2 = set2->storage.words;
+
+        // Accumulate instead of returning early so the loops vectorize
+        uint64_t extra = 0;
+        for (size_t w = 0; w < n; w++) {
+            extra |= words1[w] & ~words2[w];
+        }
+        for (size_t w = n; w < n1; w++) {
+            extra |= words1[w];
+        }
+        return extra == 0;
+    }
+
+    static bool isEqualSet(const BitSet<C, KeyOf>* set1, const BitSet<C, KeyOf>* set2) {
+        if (set1->size != set2->size) {
+            return false;
+        }
+
+        // Sets of equal size with set1 a subset of set2 are equal
+        return isSubset(set1, set2);
+    }
+};
+
+#endif // BITSET_H
@@ -2,7 +2,7 @@
 #define COLLECTION_H
 
 #include <functional>
-#include "owneddatanode.h"
+#include "ownershiptable.h"
 
 /**
  * @class Collection
@@ -12,12 +12,14 @@
  * This class provides basic memory management functionality that child classes
  * like List and Set can inherit. It manages a simple ownership tracking system
  * that allows collection classes to take ownership of elements and ensure proper
- * cleanup when the collection is destroyed.
+ * cleanup when the collection is destroyed. Owned pointers are kept in an
+ * OwnershipTable, so ownership checks are O(1) on average regardless of how
+ * many elements the collection owns.
  */
 template<class C, class Compare = std::equal_to<C>> class Collection
 {
 protected:
-    OwnedDataNode<C>* ownedHead;  // Head of the ownership tracking list
+    OwnershipTable<C> owned;      // Hash table of the data pointers we own
     int size;                     // Number of elements in the collection
     Compare equalTo;
     
@@ -27,7 +29,6 @@ public:
      */
     Collection() {
         this->size = 0;
-        this->ownedHead = nullptr;
     }
     
     /**
@@ -36,7 +37,6 @@ public:
      */
     Collection(const Compare& comp) {
         this->size = 0;
-        this->ownedHead = nullptr;
         this->equalTo = comp;
     }
     
@@ -45,21 +45,16 @@ public:
      */
     virtual ~Collection() {
         // Clean up owned data
-        OwnedDataNode<C>* current = this->ownedHead;
-        while (current != nullptr) {
-            OwnedDataNode<C>* next = current->next();
-            
+        for (size_t i = 0; i < this->owned.getCapacity(); i++) {
+            C* data = this->owned.slot(i);
+
             // Delete the owned data
-            if (current->data() != nullptr) {
-                delete current->data();
+            if (data != nullptr) {
+                delete data;
             }
-            
-            // Delete the node
-            delete current;
-            current = next;
         }
-        
-        this->ownedHead = nullptr;
+
+        this->owned.clear();
     }
     
     /**
@@ -67,16 +62,12 @@ public:
      * @param data The element to take ownership of
      */
     void takeOwnership(C* data) {
-        if (data == nullptr || hasOwnership(data)) {
-            return;  // Don't take ownership of nullptr or already owned data
+        if (data == nullptr) {
+            return;  // Don't take ownership of nullptr
         }
         
-        // Create a new ownership node
-        OwnedDataNode<C>* newNode = new OwnedDataNode<C>(data);
-        
-        // Insert at head (O(1) operation)
-        newNode->setNext(this->ownedHead);
-        this->ownedHead = newNode;
+        // Already owned data is left untouched by the table (O(1) average)
+        this->owned.insert(data);
     }
     
     /**
@@ -84,29 +75,11 @@ public:
      * @param data The element to release ownership of
      */
     void releaseOwnership(C* data) {
-        if (data == nullptr || this->ownedHead == nullptr) {
-            return;
-        }
-        
-        // Special case for head
-        if (this->ownedHead->data() == data) {
-            OwnedDataNode<C>* oldHead = this->ownedHead;
-            this->ownedHead = this->ownedHead->next();
-            delete oldHead;
+        if (data == nullptr) {
             return;
         }
         
-        // Search for the data in our ownership list
-        OwnedDataNode<C>* current = this->ownedHead;
-        while (current->next() != nullptr) {
-            if (current->next()->data() == data) {
-                OwnedDataNode<C>* toDelete = current->next();
-                current->setNext(toDelete->next());
-                delete toDelete;
-                return;
-            }
-            current = current->next();
-        }
+        this->owned.remove(data);
     }
     
     /**
@@ -119,15 +92,7 @@ public:
             return false;
         }
         
-        OwnedDataNode<C>* current = this->ownedHead;
-        while (current != nullptr) {
-            if (current->data() == data) {
-                return true;
-            }
-            current = current->next();
-        }
-        
-        return false;
+        return this->owned.contains(data);
     }
     
     /**
@@ -0,0 +1,234 @@
+#ifndef CONNECTEDCOMPONENTS_H
+#define CONNECTEDCOMPONENTS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "graph.h"
+#include "csrgraph.h"
+#include "disjointset.h"
+#include "threadpool.h"
+
+// Afforest links this many neighbours of every vertex before it looks for
+// the largest component, and samples this many vertices to find it
+static const uint32_t afforestNeighbourRounds = 2;
+static const uint32_t afforestSamples = 1024;
+
+/**
+ * @struct Components
+ * @brief Weakly connected components of a graph, indexed by vertex ID
+ *
+ * Edge directions are ignored, so two vertices share a component when a
+ * path joins them using edges either way. Components are numbered
+ * 0 .. getComponentCount() - 1 in the order of their lowest vertex ID, so
+ * the numbering depends only on the graph, not on how it was computed.
+ */
+struct Components
+{
+    std::vector<uint32_t> component;  // Component ID of each vertex ID
+    uint32_t componentCount;
+
+    Components() : componentCount(0) {
+    }
+
+    uint32_t getComponentCount() const {
+        return this->componentCount;
+    }
+
+    uint32_t getComponent(uint32_t id) const {
+        return this->component[id];
+    }
+};
+
+// Weakly connected components with a DisjointSet, one unite per edge.
+// O((V + E) α(V)).
+template<typename T>
+int connectedComponents(const CsrGraph<T>* graph, Components& components) {
+    if (!graph) {
+        return -1;
+    }
+
+    uint32_t vertexCount = static_cast<uint32_t>(graph->getVertexCount());
+    DisjointSet sets(vertexCount);
+
+    for (uint32_t id = 0; id < vertexCount; id++) {
+        for (const uint32_t* adj = graph->adjacentBegin(id); adj != graph->adjacentEnd(id); adj++) {
+            sets.unite(id, *adj);
+        }
+    }
+
+    // Number the roots in order of each set's lowest member
+    std::vector<uint32_t> number(vertexCount, CsrGraph<T>::noVertex);
+    components.component.resize(vertexCount);
+    components.componentCount = 0;
+
+    for (uint32_t id = 0; id < vertexCount; id++) {
+        uint32_t root = sets.find(id);
+        if (number[root] == CsrGraph<T>::noVertex) {
+            number[root] = components.componentCount++;
+        }
+        components.component[id] = number[root];
+    }
+
+    return 0;
+}
+
+// Lock-free union of the trees holding u and v. Roots only ever point to a
+// smaller ID, hooked with a compare-and-swap, so every root is the lowest
+// ID of its tree and concurrent links cannot form a cycle.
+inline void afforestLink(std::atomic<uint32_t>* parent, uint32_t u, uint32_t v) {
+    uint32_t p1 = parent[u].load(std::memory_order_relaxed);
+    uint32_t p2 = parent[v].load(std::memory_order_relaxed);
+
+    while (p1 != p2) {
+        uint32_t high = std::max(p1, p2);
+        uint32_t low = std::min(p1, p2);
+        uint32_t highParent = parent[high].load(std::memory_order_relaxed);
+
+        // Done when high already hangs under low, or when we hang it there
+        if (highParent == low) {
+            break;
+        }
+        if (highParent == high && parent[high].compare_exchange_strong(highParent, low, std::memory_order_relaxed)) {
+            break;
+        }
+
+        p1 = parent[parent[high].load(std::memory_order_relaxed)].load(std::memory_order_relaxed);
+        p2 = parent[low].load(std::memory_order_relaxed);
+    }
+}
+
+// Point a vertex straight at its root
+inline void afforestCompress(std::atomic<uint32_t>* parent, uint32_t id) {
+    uint32_t up = parent[id].load(std::memory_order_relaxed);
+    uint32_t upper = parent[up].load(std::memory_order_relaxed);
+
+    while (up != upper) {
+        parent[id].store(upper, std::memory_order_relaxed);
+        up = upper;
+        upper = parent[up].load(std::memory_order_relaxed);
+    }
+}
+
+// Weakly connected components on a thread pool with Afforest (Sutton et
+// al.), a lock-free union-find that skips most of the edges:
+//
+//  1. Link every vertex with its first afforestNeighbourRounds neighbours
+//     and compress. On graphs with a giant component this already puts
+//     most vertices in it.
+//  2. Sample afforestSamples vertices to guess the largest component.
+//  3. Link the remaining edges of the vertices outside that component,
+//     both out-edges and in-edges so directions do not matter. Edges of
+//     the vertices inside it cannot join anything new to it that the
+//     other end's in-edges would not, so they are skipped.
+//
+// Gives the same Components as connectedComponents.
+template<typename T>
+int parallelConnectedComponents(const CsrGraph<T>* graph, Components& components, ThreadPool& pool) {
+    if (!graph) {
+        return -1;
+    }
+
+    uint32_t vertexCount = static_cast<uint32_t>(graph->getVertexCount());
+    std::unique_ptr<std::atomic<uint32_t>[]> parent(new std::atomic<uint32_t>[vertexCount]);
+
+    // Run visit(id) for every vertex ID on the pool
+    auto forEachVertex = [&](auto visit) {
+        parallelFor(pool, vertexCount, parallelChunk, [&](unsigned, size_t id) {
+            visit(static_cast<uint32_t>(id));
+        });
+    };
+
+    forEachVertex([&](uint32_t id) {
+        parent[id].store(id, std::memory_order_relaxed);
+    });
+
+    // 1. Sparse sampling of the first neighbours
+    for (uint32_t round = 0; round < afforestNeighbourRounds; round++) {
+        forEachVertex([&](uint32_t id) {
+            if (round < graph->degree(id)) {
+                afforestLink(parent.get(), id, graph->adjacentBegin(id)[round]);
+            }
+        });
+        forEachVertex([&](uint32_t id) {
+            afforestCompress(parent.get(), id);
+        });
+    }
+
+    // 2. The most frequent root among a fixed sample of vertices
+    uint32_t largest = CsrGraph<T>::noVertex;
+    if (vertexCount > 0) {
+        std::mt19937 rng(27491095);
+        std::uniform_int_distribution<uint32_t> pick(0, vertexCount - 1);
+        std::unordered_map<uint32_t, uint32_t> counts;
+        uint32_t best = 0;
+
+        for (uint32_t sample = 0; sample < afforestSamples; sample++) {
+            uint32_t root = parent[pick(rng)].load(std::memory_order_relaxed);
+            if (++counts[root] > best) {
+                best = counts[root];
+                largest = root;
+            }
+        }
+    }
+
+    // 3. Finish the vertices outside the largest component
+    forEachVertex([&](uint32_t id) {
+        if (parent[id].load(std::memory_order_relaxed) == largest) {
+            return;
+        }
+
+        const uint32_t* adj = graph->adjacentBegin(id) + std::min(afforestNeighbourRounds, graph->degree(id));
+        for (; adj != graph->adjacentEnd(id); adj++) {
+            afforestLink(parent.get(), id, *adj);
+        }
+        for (adj = graph->incomingBegin(id); adj != graph->incomingEnd(id); adj++) {
+            afforestLink(parent.get(), id, *adj);
+        }
+    });
+    forEachVertex([&](uint32_t id) {
+        afforestCompress(parent.get(), id);
+    });
+
+    // Every root is the lowest ID of its component, so numbering the roots
+    // in ID order matches connectedComponents
+    components.component.resize(vertexCount);
+    components.componentCount = 0;
+
+    for (uint32_t id = 0; id < vertexCount; id++) {
+        uint32_t root = parent[id].load(std::memory_order_relaxed);
+        components.component[id] = root == id ? components.componentCount++ : components.component[root];
+    }
+
+    return 0;
+}
+
+// Weakly connected components of a Graph. The list-based graph is snapshot
+// to a CsrGraph first, so vertex ID i is the i-th vertex of the graph's
+// adjacency lists, as in CsrGraph.
+template<typename T, typename Compare, typename Hash, typename AdjacentSet>
+int connectedComponents(Graph<T, Compare, Hash, AdjacentSet>* graph, Components& components) {
+    if (!graph) {
+        return -1;
+    }
+
+    CsrGraph<T> snapshot(*graph);
+    return connectedComponents(&snapshot, components);
+}
+
+template<typename T, typename Compare, typename Hash, typename AdjacentSet>
+int parallelConnectedComponents(Graph<T, Compare, Hash, AdjacentSet>* graph, Components& components, ThreadPool& pool) {
+    if (!graph) {
+        return -1;
+    }
+
+    CsrGraph<T> snapshot(*graph);
+    return parallelConnectedComponents(&snapshot, components, pool);
+}
+
+#endif // CONNECTEDCOMPONENTS_H
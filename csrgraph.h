@@ -0,0 +1,242 @@
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "graph.h"
+#include "hashindex.h"
+
+/**
+ * @class CsrGraph
+ * @brief Immutable compressed sparse row snapshot of a Graph
+ *
+ * Every vertex gets a dense ID in [0, V), in the order of the graph's
+ * adjacency lists. The neighbours of vertex v are the IDs
+ * neighbours[offsets[v] .. offsets[v + 1]), in the order of its adjacent
+ * set, so a traversal reads two contiguous arrays instead of chasing list,
+ * adjacency and set nodes for every edge. vertex(id) and idOf(vertex) map
+ * between IDs and the graph's vertex objects.
+ *
+ * weightsBegin(v) .. weightsEnd(v) are the weights of those edges, in the
+ * same order, 1 for edges the graph stores no weight for.
+ *
+ * The edges are also stored reversed: incomingBegin(v) .. incomingEnd(v)
+ * are the IDs of the vertices with an edge to v, in increasing order, for
+ * bottom-up traversals that look for a parent among the in-neighbours.
+ *
+ * The snapshot does not own the vertices and does not follow later changes
+ * to the graph; build a new one after modifying it.
+ */
+template<class C> class CsrGraph
+{
+private:
+    // Vertex index entries are the slots of the vertices array, matched by
+    // object identity, so an ID is the entry's offset in that array
+    struct VertexAddress {
+        C* operator()(C* const* entry) const {
+            return *entry;
+        }
+    };
+
+    struct SameVertex {
+        bool operator()(const C& a, const C& b) const {
+            return &a == &b;
+        }
+    };
+
+    struct AddressHash {
+        size_t operator()(const C& vertex) const {
+            return std::hash<const C*>()(&vertex);
+        }
+    };
+
+    std::vector<uint32_t> offsets;       // V + 1 row starts into neighbours
+    std::vector<uint32_t> neighbours;    // E neighbour IDs, grouped by source vertex
+    std::vector<double> weights;         // E edge weights, parallel to neighbours
+    std::vector<uint32_t> inOffsets;     // V + 1 row starts into inNeighbours
+    std::vector<uint32_t> inNeighbours;  // E source IDs, grouped by destination vertex
+    std::vector<C*> vertices;            // Vertex object of each ID
+    HashIndex<C* const, C, AddressHash, SameVertex, VertexAddress> ids;
+
+    // Counting sort of the edges by destination. Sources are visited in
+    // increasing order, so every incoming row comes out sorted.
+    void buildIncoming() {
+        size_t vertexCount = this->vertices.size();
+        this->inOffsets.assign(vertexCount + 1, 0);
+        this->inNeighbours.resize(this->neighbours.size());
+
+        for (uint32_t target : this->neighbours) {
+            this->inOffsets[target + 1]++;
+        }
+        for (size_t id = 0; id < vertexCount; id++) {
+            this->inOffsets[id + 1] += this->inOffsets[id];
+        }
+
+        std::vector<uint32_t> fill(this->inOffsets.begin(), this->inOffsets.end() - 1);
+        for (uint32_t id = 0; id < vertexCount; id++) {
+            for (uint32_t k = this->offsets[id]; k < this->offsets[id + 1]; k++) {
+                this->inNeighbours[fill[this->neighbours[k]]++] = id;
+            }
+        }
+    }
+
+public:
+    static constexpr uint32_t noVertex = UINT32_MAX;
+
+    /**
+     * @brief Snapshot a graph in O(V + E)
+     * @param graph The graph to copy the structure of
+     *
+     * Neighbours are mapped to IDs by object identity. A neighbour that is
+     * a different object equal to a vertex (under the graph's Compare) is
+     * resolved with one graph lookup.
+     */
+    template<class Compare, class Hash, class AdjacentSet>
+    CsrGraph(const Graph<C, Compare, Hash, AdjacentSet>& graph) {
+        size_t vertexCount = static_cast<size_t>(graph.getVertexCount());
+
+        this->vertices.reserve(vertexCount);
+        this->offsets.reserve(vertexCount + 1);
+        this->neighbours.reserve(static_cast<size_t>(graph.getEdgeCount()));
+        this->weights.reserve(static_cast<size_t>(graph.getEdgeCount()));
+
+        for (auto node = graph.getAdjacencyListHead(); node != nullptr; node = node->next()) {
+            this->vertices.push_back(node->data()->vertex);
+        }
+
+        // The vertices array is final, so its slots can be indexed
+        for (size_t id = 0; id < this->vertices.size(); id++) {
+            this->ids.insert(&this->vertices[id]);
+        }
+
+        this->offsets.push_back(0);
+        for (auto node = graph.getAdjacencyListHead(); node != nullptr; node = node->next()) {
+            for (auto member = node->data()->adjacent.head(); member != nullptr; member = member->next()) {
+                uint32_t id = this->idOf(member->data());
+
+                if (id == noVertex && member->data() != nullptr) {
+                    auto target = graph.findNodeByVertex(member->data());
+                    if (target != nullptr) {
+                        id = this->idOf(target->data()->vertex);
+                    }
+                }
+
+                // Edges to vertices that are not in the graph are dropped
+                if (id != noVertex) {
+                    this->neighbours.push_back(id);
+                    this->weights.push_back(node->data()->getWeight(this->vertices[id]));
+                }
+            }
+            this->offsets.push_back(static_cast<uint32_t>(this->neighbours.size()));
+        }
+
+        this->buildIncoming();
+    }
+
+    // The vertex index refers to the vertices array, so no copies
+    CsrGraph(const CsrGraph&) = delete;
+    CsrGraph& operator=(const CsrGraph&) = delete;
+
+    int getVertexCount() const {
+        return static_cast<int>(this->vertices.size());
+    }
+
+    int getEdgeCount() const {
+        return static_cast<int>(this->neighbours.size());
+    }
+
+    // Vertex object with the given ID
+    C* vertex(uint32_t id) const {
+        return this->vertices[id];
+    }
+
+    // ID of a vertex object of the graph, or noVertex
+    uint32_t idOf(const C* data) const {
+        C* const* entry = this->ids.find(data);
+        return entry == nullptr ? noVertex : static_cast<uint32_t>(entry - this->vertices.data());
+    }
+
+    uint32_t degree(uint32_t id) const {
+        return this->offsets[id + 1] - this->offsets[id];
+    }
+
+    // Neighbour IDs of a vertex are [adjacentBegin(id), adjacentEnd(id))
+    const uint32_t* adjacentBegin(uint32_t id) const {
+        return this->neighbours.data() + this->offsets[id];
+    }
+
+    const uint32_t* adjacentEnd(uint32_t id) const {
+        return this->neighbours.data() + this->offsets[id + 1];
+    }
+
+    // Weights of the edges [adjacentBegin(id), adjacentEnd(id)), in order
+    const double* weightsBegin(uint32_t id) const {
+        return this->weights.data() + this->offsets[id];
+    }
+
+    const double* weightsEnd(uint32_t id) const {
+        return this->weights.data() + this->offsets[id + 1];
+    }
+
+    uint32_t inDegree(uint32_t id) const {
+        return this->inOffsets[id + 1] - this->inOffsets[id];
+    }
+
+    // IDs of the vertices with an edge to a vertex are
+    // [incomingBegin(id), incomingEnd(id)), in increasing order
+    const uint32_t* incomingBegin(uint32_t id) const {
+        return this->inNeighbours.data() + this->inOffsets[id];
+    }
+
+    const uint32_t* incomingEnd(uint32_t id) const {
+        return this->inNeighbours.data() + this->inOffsets[id + 1];
+    }
+
+    // Raw arrays, for kernels that work on the whole graph
+    const uint32_t* getOffsets() const {
+        return this->offsets.data();
+    }
+
+    const uint32_t* getNeighbours() const {
+        return this->neighbours.data();
+    }
+
+    const double* getWeights() const {
+        return this->weights.data();
+    }
+
+    /**
+     * @brief Sort every neighbour list by ID
+     *
+     * Sorted rows can be intersected with the kernels in sortedkernels.h.
+     * Traversals stay correct but visit neighbours in ID order instead of
+     * the order of the graph's adjacent sets.
+     */
+    void sortNeighbours() {
+        std::vector<std::pair<uint32_t, double>> row;
+
+        for (size_t id = 0; id < this->vertices.size(); id++) {
+            uint32_t begin = this->offsets[id];
+            uint32_t end = this->offsets[id + 1];
+
+            // Weights move with their neighbours
+            row.clear();
+            for (uint32_t k = begin; k < end; k++) {
+                row.push_back(std::make_pair(this->neighbours[k], this->weights[k]));
+            }
+            std::sort(row.begin(), row.end());
+
+            for (uint32_t k = begin; k < end; k++) {
+                this->neighbours[k] = row[k - begin].first;
+                this->weights[k] = row[k - begin].second;
+            }
+        }
+    }
+};
+
+#endif // CSRGRAPH_H
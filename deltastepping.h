@@ -0,0 +1,260 @@
+#ifndef DELTASTEPPING_H
+#define DELTASTEPPING_H
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "graph.h"
+#include "csrgraph.h"
+#include "dijkstra.h"
+#include "threadpool.h"
+
+// Buckets each thread keeps at most. A delta that would need more is
+// raised until they suffice, which only makes the buckets coarser.
+static const size_t deltaSteppingMaxSlots = 65536;
+
+// An edge relaxation that lowered a distance: target can be reached at
+// distance through from
+struct DeltaRelaxation
+{
+    uint32_t target;
+    uint32_t from;
+    double distance;
+};
+
+// Single-source shortest paths on a thread pool with delta-stepping (Meyer
+// and Sanders). Gives the same distances as dijkstra; parents may differ
+// where two shortest paths tie.
+//
+// Vertices are kept in buckets of width delta by tentative distance, and
+// the lowest non-empty bucket is settled in phases. Edges no heavier than
+// delta are light: relaxing one from bucket i lands in bucket i or later,
+// so the bucket's vertices relax their light edges phase after phase until
+// none of them improves. Then their distances are final and they relax
+// their heavy edges once. A small delta settles few vertices per phase and
+// approaches Dijkstra, a large one relaxes many edges more than once and
+// approaches Bellman-Ford; around the average edge weight is a good start.
+//
+// No vertex waits for more than maxWeight past the bucket being settled,
+// so bucket b is kept in slot b % slotCount of a cyclic array of
+// ceil(maxWeight / delta) + 1 slots, plus one for rounding, and a delta
+// far below the edge weights costs no memory beyond that. The array is
+// capped at deltaSteppingMaxSlots slots by raising delta if needed.
+//
+// Every phase the threads claim chunks of the bucket from a shared cursor
+// and lower distances with a compare-and-swap, keeping the relaxations
+// that won in per-thread light and heavy buffers. After a barrier, the one
+// relaxation that set each vertex's new distance records the parent and
+// files the vertex into the thread's own buckets, and the next bucket is
+// merged from them with a prefix sum, as in parallelBfs.
+//
+// Returns -1 for a source out of range, a delta that is not positive, or a
+// negative edge weight.
+template<typename T>
+int deltaStepping(const CsrGraph<T>* graph, uint32_t source, double delta, ShortestPathTree& tree, ThreadPool& pool) {
+    if (!graph || source >= static_cast<uint32_t>(graph->getVertexCount()) || !(delta > 0)) {
+        return -1;
+    }
+
+    const double infinity = std::numeric_limits<double>::infinity();
+    const double* weights = graph->getWeights();
+    double maxWeight = 0;  // Largest weight an edge can be relaxed along
+
+    for (size_t edge = 0; edge < static_cast<size_t>(graph->getEdgeCount()); edge++) {
+        if (weights[edge] < 0) {
+            return -1;  // Negative weight
+        }
+        if (weights[edge] > maxWeight && weights[edge] != infinity) {
+            maxWeight = weights[edge];
+        }
+    }
+
+    delta = std::max(delta, maxWeight / (deltaSteppingMaxSlots - 2));
+    const size_t slotCount = static_cast<size_t>(std::ceil(maxWeight / delta)) + 2;
+    const size_t noBucket = SIZE_MAX;
+    auto bucketOf = [delta](double distance) {
+        return static_cast<size_t>(distance / delta);
+    };
+
+    uint32_t vertexCount = static_cast<uint32_t>(graph->getVertexCount());
+    unsigned threadCount = pool.getThreadCount();
+    std::unique_ptr<std::atomic<double>[]> distance(new std::atomic<double>[vertexCount]);
+    std::unique_ptr<std::atomic<uint32_t>[]> claimed(new std::atomic<uint32_t>[vertexCount]);
+    for (uint32_t id = 0; id < vertexCount; id++) {
+        distance[id].store(infinity, std::memory_order_relaxed);
+        claimed[id].store(UINT32_MAX, std::memory_order_relaxed);
+    }
+    tree.parents.assign(vertexCount, ShortestPathTree::noParent);
+
+    // Each thread files the vertices it improves into buckets of its own
+    std::vector<std::vector<std::vector<uint32_t>>> buckets(threadCount, std::vector<std::vector<uint32_t>>(slotCount));
+    std::vector<size_t> lowest(threadCount, noBucket);  // Lowest bucket a thread may have filled
+    std::vector<size_t> filed(threadCount);
+    std::vector<uint32_t> frontier;
+    std::atomic<size_t> cursor(0);
+
+    distance[source].store(0, std::memory_order_relaxed);
+    buckets[0][0].push_back(source);
+    lowest[0] = 0;
+
+    pool.run([&](unsigned thread) {
+        std::vector<std::vector<uint32_t>>& local = buckets[thread];
+        std::vector<DeltaRelaxation> light;
+        std::vector<DeltaRelaxation> heavy;
+        std::vector<uint32_t> settled;  // Vertices of the current bucket this thread expanded
+        uint32_t phase = 0;
+
+        // Lower target to candidate if that is shorter, keeping the win
+        auto relax = [&](std::vector<DeltaRelaxation>& won, uint32_t from, uint32_t target, double candidate) {
+            double current = distance[target].load(std::memory_order_relaxed);
+            while (candidate < current) {
+                if (distance[target].compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+                    won.push_back(DeltaRelaxation{target, from, candidate});
+                    return;
+                }
+            }
+        };
+
+        // Distances only go down during a phase, so each vertex's final one
+        // for the phase was set by exactly one winning relaxation, which
+        // alone records the parent and files the vertex
+        auto commit = [&](std::vector<DeltaRelaxation>& won) {
+            for (const DeltaRelaxation& relaxation : won) {
+                if (distance[relaxation.target].load(std::memory_order_relaxed) != relaxation.distance) {
+                    continue;  // Lowered again by another relaxation
+                }
+
+                tree.parents[relaxation.target] = relaxation.from;
+                size_t bucket = bucketOf(relaxation.distance);
+                local[bucket % slotCount].push_back(relaxation.target);
+                lowest[thread] = std::min(lowest[thread], bucket);
+            }
+            won.clear();
+        };
+
+        while (true) {
+            // The next bucket is the lowest non-empty one of any thread. A
+            // thread's buckets lie within slotCount of its lowest.
+            if (lowest[thread] != noBucket) {
+                size_t last = lowest[thread] + slotCount;
+                while (lowest[thread] < last && local[lowest[thread] % slotCount].empty()) {
+                    lowest[thread]++;
+                }
+                if (lowest[thread] == last) {
+                    lowest[thread] = noBucket;
+                }
+            }
+            pool.barrier();
+
+            size_t bucket = *std::min_element(lowest.begin(), lowest.end());
+            if (bucket == noBucket) {
+                break;
+            }
+
+            // Light phases, until no vertex improves to within the bucket
+            while (true) {
+                std::vector<uint32_t>& slot = local[bucket % slotCount];
+                filed[thread] = slot.size();
+                pool.barrier();
+
+                size_t offset = 0;
+                size_t total = 0;
+                for (unsigned t = 0; t < threadCount; t++) {
+                    if (t < thread) {
+                        offset += filed[t];
+                    }
+                    total += filed[t];
+                }
+                if (total == 0) {
+                    break;
+                }
+
+                if (thread == 0) {
+                    frontier.resize(total);
+                    cursor.store(0, std::memory_order_relaxed);
+                }
+                pool.barrier();
+
+                std::copy(slot.begin(), slot.end(), frontier.begin() + offset);
+                slot.clear();
+                pool.barrier();
+
+                forEachClaimed(cursor, total, parallelChunk, [&](size_t i) {
+                    uint32_t vertex = frontier[i];
+                    double reached = distance[vertex].load(std::memory_order_relaxed);
+
+                    // Skip vertices that moved to a lower bucket since they
+                    // were filed here, and second copies
+                    if (bucketOf(reached) != bucket || claimed[vertex].exchange(phase, std::memory_order_relaxed) == phase) {
+                        return;
+                    }
+                    settled.push_back(vertex);
+
+                    const double* weight = graph->weightsBegin(vertex);
+                    for (const uint32_t* adj = graph->adjacentBegin(vertex); adj != graph->adjacentEnd(vertex); adj++, weight++) {
+                        if (*weight <= delta) {
+                            relax(light, vertex, *adj, reached + *weight);
+                        }
+                    }
+                });
+                pool.barrier();
+
+                commit(light);
+                phase++;
+            }
+
+            // The bucket is settled, so its heavy edges are relaxed once
+            for (uint32_t vertex : settled) {
+                double reached = distance[vertex].load(std::memory_order_relaxed);
+                if (bucketOf(reached) != bucket || claimed[vertex].exchange(phase, std::memory_order_relaxed) == phase) {
+                    continue;  // Expanded more than once in the bucket
+                }
+
+                const double* weight = graph->weightsBegin(vertex);
+                for (const uint32_t* adj = graph->adjacentBegin(vertex); adj != graph->adjacentEnd(vertex); adj++, weight++) {
+                    if (*weight > delta) {
+                        relax(heavy, vertex, *adj, reached + *weight);
+                    }
+                }
+            }
+            settled.clear();
+            pool.barrier();
+
+            commit(heavy);
+            phase++;
+        }
+    });
+
+    tree.distances.resize(vertexCount);
+    for (uint32_t id = 0; id < vertexCount; id++) {
+        tree.distances[id] = distance[id].load(std::memory_order_relaxed);
+    }
+
+    return 0;
+}
+
+// Delta-stepping on a Graph. The list-based graph is snapshot to a
+// CsrGraph first, so vertex ID i is the i-th vertex of the graph's
+// adjacency lists, as in CsrGraph. Returns -1 when source is not in the
+// graph.
+template<typename T, typename Compare, typename Hash, typename AdjacentSet>
+int deltaStepping(Graph<T, Compare, Hash, AdjacentSet>* graph, T* source, double delta, ShortestPathTree& tree, ThreadPool& pool) {
+    if (!graph || !source) {
+        return -1;
+    }
+
+    ListNode<AdjacentList<T, Compare, Hash, AdjacentSet>>* node = graph->findNodeByVertex(source);
+    if (node == nullptr) {
+        return -1;  // Starting vertex not found
+    }
+
+    CsrGraph<T> snapshot(*graph);
+    return deltaStepping(&snapshot, snapshot.idOf(node->data()->vertex), delta, tree, pool);
+}
+
+#endif // DELTASTEPPING_H
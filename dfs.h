@@ -2,6 +2,9 @@
 #define DFS_H
 
 #include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "dfsvertex.h"
 #include "list.h"
@@ -9,42 +12,109 @@
 #include "setnode.h"
 #include "adjacentlist.h"
 #include "graph.h"
+#include "csrgraph.h"
+#include "traversalstate.h"
+
+// Map each vertex pointer to its adjacency list, so dfsMain can follow an
+// edge without a lookup through the graph's Compare, which is a linear scan
+// when the graph is not hashed.
+template<typename T, typename Compare, typename Hash, typename AdjacentSet>
+void indexAdjacentLists(Graph<T, Compare, Hash, AdjacentSet>* graph,
+                        std::unordered_map<const T*, AdjacentList<T, Compare, Hash, AdjacentSet>*>& index) {
+    index.clear();
+    index.reserve(graph->getVertexCount());
+
+    for (auto node = graph->getAdjacencyListHead();node != nullptr;node = node->next()) {
+        index[node->data()->vertex] = node->data();
+    }
+}
 
-template<typename T, typename Compare = std::equal_to<T>>
-int dfsMain(Graph<T, Compare>* graph, AdjacentList<T, Compare>* adjList, List<T, Compare>* ordered) {
-    AdjacentList<T, Compare>* clrAdjList;
-    T* clrVertex;
-    T* adjVertex;
-    SetNode<T>* member;
+// Visit everything reachable from adjList that is still white, inserting
+// vertices at the head of ordered as they finish. The frames on stack pair
+// an adjacency list with the next neighbour entry to look at, which is what
+// a recursive call would keep in its locals, so a path of any length costs
+// heap instead of call stack. stack is scratch space owned by the caller to
+// reuse its allocation across roots, and index comes from
+// indexAdjacentLists.
+template<typename T, typename Compare, typename Hash, typename AdjacentSet, typename Frame>
+int dfsMain(Graph<T, Compare, Hash, AdjacentSet>* graph,
+            AdjacentList<T, Compare, Hash, AdjacentSet>* adjList,
+            List<T, Compare>* ordered,
+            std::vector<Frame>& stack,
+            const std::unordered_map<const T*, AdjacentList<T, Compare, Hash, AdjacentSet>*>& index) {
 
     adjList->vertex->setColor(gray);
+    stack.push_back(Frame(adjList, adjList->adjacent.head()));
 
-    for (member = adjList->adjacent.head();member != nullptr;member = member->next()) {
-        adjVertex = member->data();
+    while (!stack.empty()) {
+        AdjacentList<T, Compare, Hash, AdjacentSet>* current = stack.back().first;
 
-        graph->buildAdjacentList(adjVertex, &clrAdjList);
+        // Neighbour entries are SetNode or FlatSetNode depending on AdjacentSet
+        auto& member = stack.back().second;
 
-        clrVertex = clrAdjList->vertex;
+        // Skip to the next white neighbour, if any
+        AdjacentList<T, Compare, Hash, AdjacentSet>* child = nullptr;
+        while (member != nullptr && child == nullptr) {
+            AdjacentList<T, Compare, Hash, AdjacentSet>* target;
+            auto found = index.find(member->data());
 
-        if (clrVertex->getColor() == white) {
-            if (dfsMain(graph, clrAdjList, ordered) != 0) {
-                return -1;
+            if (found != index.end()) {
+                target = found->second;
+            } else {
+                // The edge was inserted with an equal vertex rather than the
+                // one the graph holds
+                ListNode<AdjacentList<T, Compare, Hash, AdjacentSet>>* node = graph->findNodeByVertex(member->data());
+
+                if (node == nullptr) {
+                    return -1;  // Edge to a vertex that is not in the graph
+                }
+
+                target = node->data();
+            }
+
+            member = member->next();
+
+            if (target->vertex->getColor() == white) {
+                child = target;
             }
         }
+
+        if (child != nullptr) {
+            child->vertex->setColor(gray);
+            stack.push_back(Frame(child, child->adjacent.head()));
+        } else {
+            current->vertex->setColor(black);
+            ordered->insertUnchecked(nullptr, current->vertex);
+            stack.pop_back();
+        }
     }
 
-    adjList->vertex->setColor(black);
+    return 0;
+}
 
-    ordered->insert(nullptr, adjList->vertex);
+// Single-root form for callers that do not keep their own scratch space
+template<typename T, typename Compare = std::equal_to<T>, typename Hash = NoHash<T>, typename AdjacentSet = Set<T, Compare, Hash>>
+int dfsMain(Graph<T, Compare, Hash, AdjacentSet>* graph, AdjacentList<T, Compare, Hash, AdjacentSet>* adjList, List<T, Compare>* ordered) {
+    typedef std::pair<AdjacentList<T, Compare, Hash, AdjacentSet>*, decltype(adjList->adjacent.head())> Frame;
+    std::vector<Frame> stack;
+    std::unordered_map<const T*, AdjacentList<T, Compare, Hash, AdjacentSet>*> index;
 
-    return 0;
+    indexAdjacentLists(graph, index);
+
+    return dfsMain(graph, adjList, ordered, stack, index);
 }
 
-template<typename T, typename Compare = std::equal_to<T>>
-int dfs(Graph<T, Compare>* graph, List<T, Compare>& ordered) {
+template<typename T, typename Compare = std::equal_to<T>, typename Hash = NoHash<T>, typename AdjacentSet = Set<T, Compare, Hash>>
+int dfs(Graph<T, Compare, Hash, AdjacentSet>* graph, List<T, Compare>& ordered) {
     T* vertex;
 
-    ListNode<AdjacentList<T, Compare>>* node;
+    ListNode<AdjacentList<T, Compare, Hash, AdjacentSet>>* node;
+
+    typedef std::pair<AdjacentList<T, Compare, Hash, AdjacentSet>*, decltype(node->data()->adjacent.head())> Frame;
+    std::vector<Frame> stack;
+    std::unordered_map<const T*, AdjacentList<T, Compare, Hash, AdjacentSet>*> index;
+
+    indexAdjacentLists(graph, index);
 
     for (node = graph->getAdjacencyListHead();node != nullptr;node = node->next()) {
         vertex = node->data()->vertex;
@@ -57,7 +127,7 @@ int dfs(Graph<T, Compare>* graph, List<T, Compare>& ordered) {
         vertex = node->data()->vertex;
 
         if (vertex->getColor() == white) {
-            if (dfsMain(graph, node->data(), &ordered) != 0) {
+            if (dfsMain(graph, node->data(), &ordered, stack, index) != 0) {
                 return -1;
             }
         }
@@ -66,4 +136,95 @@ int dfs(Graph<T, Compare>* graph, List<T, Compare>& ordered) {
     return 0;
 }
 
+// Visit everything reachable from root that is still white in state,
+// appending vertices to state.finished as they finish. An explicit stack of
+// (vertex, next edge) pairs replaces recursion, so deep graphs cannot
+// overflow the call stack.
+template<typename T>
+void dfsVisit(const CsrGraph<T>* graph, uint32_t root, DfsState& state) {
+    std::vector<std::pair<uint32_t, const uint32_t*>>& stack = state.stack;
+
+    state.setColor(root, gray);
+    stack.push_back(std::make_pair(root, graph->adjacentBegin(root)));
+
+    while (!stack.empty()) {
+        uint32_t current = stack.back().first;
+        const uint32_t*& edge = stack.back().second;
+
+        // Descend into the next white neighbour, if any
+        while (edge != graph->adjacentEnd(current) && state.getColor(*edge) != white) {
+            edge++;
+        }
+
+        if (edge != graph->adjacentEnd(current)) {
+            uint32_t child = *edge++;
+            state.setColor(child, gray);
+            stack.push_back(std::make_pair(child, graph->adjacentBegin(child)));
+        } else {
+            state.setColor(current, black);
+            state.finished.push_back(current);
+            stack.pop_back();
+        }
+    }
+}
+
+// Depth-first search over a CSR snapshot, recording colors and finishing
+// order in state instead of the vertex objects. Roots are tried in ID
+// order, like dfs tries the graph's vertices in list order.
+template<typename T>
+int dfs(const CsrGraph<T>* graph, DfsState& state) {
+    if (!graph) {
+        return -1;
+    }
+
+    uint32_t vertexCount = static_cast<uint32_t>(graph->getVertexCount());
+    state.reset(vertexCount);
+
+    for (uint32_t root = 0; root < vertexCount; root++) {
+        if (state.getColor(root) == white) {
+            dfsVisit(graph, root, state);
+        }
+    }
+
+    return 0;
+}
+
+// Depth-first search over a CSR snapshot from a single root, leaving the
+// vertices it cannot reach white. Reusing a state skips clearing it, so the
+// search costs time in proportion to the part of the graph it reaches.
+template<typename T>
+int dfs(const CsrGraph<T>* graph, uint32_t root, DfsState& state) {
+    if (!graph || root >= static_cast<uint32_t>(graph->getVertexCount())) {
+        return -1;
+    }
+
+    state.reset(static_cast<uint32_t>(graph->getVertexCount()));
+    dfsVisit(graph, root, state);
+    return 0;
+}
+
+// Depth-first search over a CSR snapshot. Produces the same colors and
+// ordering as dfs on the graph the snapshot was taken from.
+template<typename T, typename Compare = std::equal_to<T>>
+int dfs(const CsrGraph<T>* graph, List<T, Compare>& ordered) {
+    if (!graph) {
+        return -1;
+    }
+
+    DfsState state;
+    dfs(graph, state);
+
+    // Vertices finished later come first
+    ordered.clear();
+    for (uint32_t id : state.finished) {
+        ordered.insert(nullptr, graph->vertex(id));
+    }
+
+    for (uint32_t id = 0; id < state.marks.size(); id++) {
+        graph->vertex(id)->setColor(state.getColor(id));
+    }
+
+    return 0;
+}
+
 #endif // DFS_H
@@ -0,0 +1,126 @@
+#ifndef DIJKSTRA_H
+#define DIJKSTRA_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "graph.h"
+#include "csrgraph.h"
+#include "indexedheap.h"
+
+/**
+ * @struct ShortestPathTree
+ * @brief Distances and parents of a single-source shortest path search
+ *
+ * Indexed by vertex ID. Unreached vertices are at an infinite distance,
+ * and the source and the unreached vertices have no parent.
+ */
+struct ShortestPathTree
+{
+    static constexpr uint32_t noParent = UINT32_MAX;
+
+    std::vector<double> distances;
+    std::vector<uint32_t> parents;
+
+    bool isReached(uint32_t id) const {
+        return this->distances[id] != std::numeric_limits<double>::infinity();
+    }
+
+    double getDistance(uint32_t id) const {
+        return this->distances[id];
+    }
+
+    uint32_t getParent(uint32_t id) const {
+        return this->parents[id];
+    }
+
+    // Vertex IDs of the shortest path from the source to target, both
+    // included. Returns 1 and leaves path empty when target was not reached.
+    int getPath(uint32_t target, std::vector<uint32_t>& path) const {
+        path.clear();
+        if (!this->isReached(target)) {
+            return 1;
+        }
+
+        for (uint32_t id = target; id != noParent; id = this->parents[id]) {
+            path.push_back(id);
+        }
+        std::reverse(path.begin(), path.end());
+        return 0;
+    }
+};
+
+// Dijkstra's single-source shortest paths over the edge weights of a CSR
+// snapshot, with an IndexedHeap of the given arity as the priority queue.
+// Each vertex enters the heap once and is moved up with decrease-key when
+// a shorter path to it is found, so the heap never holds stale entries.
+// O((V + E) log V).
+//
+// Weights must not be negative: the search returns -1 as soon as it meets
+// a negative one, leaving tree partly filled.
+template<unsigned Arity = 4, typename T>
+int dijkstra(const CsrGraph<T>* graph, uint32_t source, ShortestPathTree& tree) {
+    if (!graph || source >= static_cast<uint32_t>(graph->getVertexCount())) {
+        return -1;
+    }
+
+    uint32_t vertexCount = static_cast<uint32_t>(graph->getVertexCount());
+    tree.distances.assign(vertexCount, std::numeric_limits<double>::infinity());
+    tree.parents.assign(vertexCount, ShortestPathTree::noParent);
+
+    IndexedHeap<double, Arity> heap(vertexCount);
+    tree.distances[source] = 0;
+    heap.push(source, 0);
+
+    uint32_t current;
+    double distance;
+    while (heap.pop(&current, &distance) == 0) {
+        const uint32_t* adj = graph->adjacentBegin(current);
+        const double* weight = graph->weightsBegin(current);
+
+        for (; adj != graph->adjacentEnd(current); adj++, weight++) {
+            if (*weight < 0) {
+                return -1;  // Negative weight
+            }
+
+            double candidate = distance + *weight;
+            if (candidate < tree.distances[*adj]) {
+                // A vertex that was reached before is either still in the
+                // heap or settled, and settled ones are never improved
+                bool queued = tree.distances[*adj] != std::numeric_limits<double>::infinity();
+                tree.distances[*adj] = candidate;
+                tree.parents[*adj] = current;
+
+                if (queued) {
+                    heap.decreaseKey(*adj, candidate);
+                } else {
+                    heap.push(*adj, candidate);
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+// Dijkstra on a Graph. The list-based graph is snapshot to a CsrGraph
+// first, so vertex ID i is the i-th vertex of the graph's adjacency lists,
+// as in CsrGraph. Returns -1 when source is not in the graph.
+template<unsigned Arity = 4, typename T, typename Compare, typename Hash, typename AdjacentSet>
+int dijkstra(Graph<T, Compare, Hash, AdjacentSet>* graph, T* source, ShortestPathTree& tree) {
+    if (!graph || !source) {
+        return -1;
+    }
+
+    ListNode<AdjacentList<T, Compare, Hash, AdjacentSet>>* node = graph->findNodeByVertex(source);
+    if (node == nullptr) {
+        return -1;  // Starting vertex not found
+    }
+
+    CsrGraph<T> snapshot(*graph);
+    return dijkstra<Arity>(&snapshot, snapshot.idOf(node->data()->vertex), tree);
+}
+
+#endif // DIJKSTRA_H
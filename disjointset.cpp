@@ -0,0 +1,6 @@
+#include "disjointset.h"
+
+// This file is mostly empty because DisjointSet is implemented
+// inline in the header file.
+// Including this file in the project for consistency with
+// the project structure.
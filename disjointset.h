@@ -0,0 +1,95 @@
+#ifndef DISJOINTSET_H
+#define DISJOINTSET_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @class DisjointSet
+ * @brief Union-find over the integers 0 .. size - 1
+ *
+ * Every element starts in a set of its own. unite() merges two sets and
+ * find() names the set of an element by one of its members, the root.
+ * Union by rank keeps the trees shallow and find() halves the path it
+ * walks, so any sequence of m operations takes O(m α(n)) time, which is
+ * effectively constant per operation.
+ *
+ * Elements are plain indices such as CsrGraph vertex IDs, so unlike the
+ * pointer collections the set owns nothing and is a pair of arrays.
+ */
+class DisjointSet
+{
+private:
+    std::vector<uint32_t> parent;
+    std::vector<uint8_t> rank;  // Upper bound on the height of each root's tree
+    uint32_t setCount;
+
+public:
+    explicit DisjointSet(uint32_t size = 0) {
+        this->reset(size);
+    }
+
+    // Put each of the size elements back in a set of its own
+    void reset(uint32_t size) {
+        this->parent.resize(size);
+        this->rank.assign(size, 0);
+        for (uint32_t element = 0; element < size; element++) {
+            this->parent[element] = element;
+        }
+        this->setCount = size;
+    }
+
+    uint32_t getSize() const {
+        return static_cast<uint32_t>(this->parent.size());
+    }
+
+    uint32_t getSetCount() const {
+        return this->setCount;
+    }
+
+    // Root of the set holding element. Every node on the way is pointed at
+    // its grandparent, which halves the path for the next find.
+    uint32_t find(uint32_t element) {
+        while (this->parent[element] != element) {
+            this->parent[element] = this->parent[this->parent[element]];
+            element = this->parent[element];
+        }
+        return element;
+    }
+
+    /**
+     * @brief Merge the sets holding a and b
+     * @return 0 if the sets were merged, 1 if a and b were already in the
+     * same set, -1 if either is out of range
+     */
+    int unite(uint32_t a, uint32_t b) {
+        if (a >= this->getSize() || b >= this->getSize()) {
+            return -1;
+        }
+
+        a = this->find(a);
+        b = this->find(b);
+        if (a == b) {
+            return 1;
+        }
+
+        // Hang the shallower tree under the deeper one
+        if (this->rank[a] < this->rank[b]) {
+            std::swap(a, b);
+        }
+        this->parent[b] = a;
+        if (this->rank[a] == this->rank[b]) {
+            this->rank[a]++;
+        }
+
+        this->setCount--;
+        return 0;
+    }
+
+    bool isSameSet(uint32_t a, uint32_t b) {
+        return this->find(a) == this->find(b);
+    }
+};
+
+#endif // DISJOINTSET_H
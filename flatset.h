@@ -0,0 +1,413 @@
+#ifndef FLATSET_H
+#define FLATSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "collection.h"
+#include "sortedkernels.h"
+
+/**
+ * @class FlatSetNode
+ * @brief Entry of a FlatSet, iterated the same way as a SetNode
+ *
+ * Entries are stored contiguously in sorted order and followed by a sentinel
+ * entry holding nullptr, so next() can step to the neighbouring entry and
+ * report the end of the set without a link pointer. Entries are invalidated
+ * by insert and remove, just like a removed SetNode.
+ */
+template<class C> class FlatSetNode
+{
+private:
+    C* data_field;
+
+public:
+    FlatSetNode(C* data = nullptr) {
+        this->data_field = data;
+    }
+
+    C* data() const {
+        return this->data_field;
+    }
+
+    // Next entry in sorted order, or nullptr after the last one
+    FlatSetNode<C>* next() const {
+        FlatSetNode<C>* following = const_cast<FlatSetNode<C>*>(this) + 1;
+        return following->data_field != nullptr ? following : nullptr;
+    }
+};
+
+/**
+ * @class FlatSet
+ * @brief Set of element pointers kept sorted in a contiguous array
+ *
+ * Elements are ordered with the Less functor, and two elements are the same
+ * member when neither is less than the other. isMember is a binary search and
+ * the set operations are linear merges; when one operand is much smaller than
+ * the other, intersection, difference and subset tests gallop through the
+ * larger one instead, so they cost O(small * log(large)).
+ *
+ * The public interface and the static set operations mirror Set, so a FlatSet
+ * can be used as the neighbour set of an AdjacentList. Iteration with
+ * head()/next() visits the members in sorted order. Null elements cannot be
+ * ordered and are ignored.
+ *
+ * A FlatSet<uint32_t> with the default ordering also keeps a copy of its
+ * keys in a plain uint32_t array. Lookups then search the keys directly and
+ * intersection, difference and subset tests run on the SIMD kernels from
+ * sortedkernels.h. Elements must not be modified while they are members.
+ */
+template<class C, class Less = std::less<C>> class FlatSet : public Collection<C>
+{
+private:
+    // Whether the members are uint32_t keys in natural order
+    static constexpr bool UsesKernels =
+        std::is_same<C, uint32_t>::value && std::is_same<Less, std::less<uint32_t>>::value;
+
+    struct NoKeys {};
+
+    std::vector<FlatSetNode<C>> entries;  // Sorted members followed by a nullptr sentinel
+    typename std::conditional<UsesKernels, std::vector<uint32_t>, NoKeys>::type keys;  // Values of the members
+    Less less;
+
+    // Size ratio above which the smaller operand gallops through the larger one
+    static const size_t gallopRatio = 16;
+
+    bool equivalent(const C* a, const C* b) const {
+        return !this->less(*a, *b) && !this->less(*b, *a);
+    }
+
+    // First index in [from, count) whose member is not less than key
+    size_t lowerBound(const C* key, size_t from) const {
+        if constexpr (UsesKernels) {
+            return std::lower_bound(this->keys.begin() + from, this->keys.end(), *key) - this->keys.begin();
+        }
+
+        size_t lo = from;
+        size_t hi = static_cast<size_t>(this->size);
+
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (this->less(*this->entries[mid].data(), *key)) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+
+        return lo;
+    }
+
+    // Same result as lowerBound, found by doubling the step from 'from'
+    // first, which is cheaper when the answer is close to 'from'
+    size_t gallop(const C* key, size_t from) const {
+        size_t count = static_cast<size_t>(this->size);
+        size_t step = 1;
+        size_t lo = from;
+
+        while (lo + step < count && this->less(*this->entries[lo + step].data(), *key)) {
+            lo += step;
+            step *= 2;
+        }
+
+        size_t hi = lo + step < count ? lo + step + 1 : count;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (this->less(*this->entries[mid].data(), *key)) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+
+        return lo;
+    }
+
+    // Replace the members with a sorted, duplicate free list of elements
+    void assign(const std::vector<C*>& sorted) {
+        this->entries.clear();
+        this->entries.reserve(sorted.size() + 1);
+        for (C* data : sorted) {
+            this->entries.push_back(FlatSetNode<C>(data));
+        }
+        this->entries.push_back(FlatSetNode<C>());
+        this->size = static_cast<int>(sorted.size());
+
+        if constexpr (UsesKernels) {
+            this->keys.clear();
+            this->keys.reserve(sorted.size());
+            for (C* data : sorted) {
+                this->keys.push_back(*data);
+            }
+        }
+    }
+
+    // Add a sorted, duplicate free list of elements to the members
+    void mergeSorted(const std::vector<C*>& sorted) {
+        if (this->size == 0) {
+            this->assign(sorted);
+            return;
+        }
+
+        std::vector<C*> merged;
+        merged.reserve(this->size + sorted.size());
+
+        size_t i = 0;
+        size_t j = 0;
+        size_t count = static_cast<size_t>(this->size);
+        while (i < count && j < sorted.size()) {
+            C* a = this->entries[i].data();
+            C* b = sorted[j];
+            if (this->less(*a, *b)) {
+                merged.push_back(a);
+                i++;
+            } else if (this->less(*b, *a)) {
+                merged.push_back(b);
+                j++;
+            } else {
+                merged.push_back(a);
+                i++;
+                j++;
+            }
+        }
+        for (; i < count; i++) {
+            merged.push_back(this->entries[i].data());
+        }
+        for (; j < sorted.size(); j++) {
+            merged.push_back(sorted[j]);
+        }
+
+        this->assign(merged);
+    }
+
+    // Members of set1 that are (keep == true) or are not (keep == false) in set2
+    static std::vector<C*> filter(const FlatSet<C, Less>* set1, const FlatSet<C, Less>* set2, bool keep) {
+        std::vector<C*> out;
+        size_t n = static_cast<size_t>(set1->size);
+        size_t m = static_cast<size_t>(set2->size);
+
+        if (m > n * gallopRatio) {
+            // set1 is tiny compared to set2: gallop through set2
+            size_t j = 0;
+            for (size_t i = 0; i < n; i++) {
+                C* a = set1->entries[i].data();
+                j = set2->gallop(a, j);
+                bool found = j < m && !set1->less(*a, *set2->entries[j].data());
+                if (found == keep) {
+                    out.push_back(a);
+                }
+            }
+            return out;
+        }
+
+        if constexpr (UsesKernels) {
+            // Positions in set1 of the selected members
+            std::vector<uint32_t> positions(n);
+            size_t count;
+            if (keep) {
+                count = sortedIntersectPositions(set1->keys.data(), n, set2->keys.data(), m, positions.data());
+            } else {
+                count = sortedDifferencePositions(set1->keys.data(), n, set2->keys.data(), m, positions.data());
+            }
+
+            out.reserve(count);
+            for (size_t k = 0; k < count; k++) {
+                out.push_back(set1->entries[positions[k]].data());
+            }
+            return out;
+        }
+
+        // Linear merge
+        size_t j = 0;
+        for (size_t i = 0; i < n; i++) {
+            C* a = set1->entries[i].data();
+            while (j < m && set1->less(*set2->entries[j].data(), *a)) {
+                j++;
+            }
+            bool found = j < m && !set1->less(*a, *set2->entries[j].data());
+            if (found == keep) {
+                out.push_back(a);
+            }
+        }
+        return out;
+    }
+
+public:
+    FlatSet() : Collection<C>() {
+        this->entries.push_back(FlatSetNode<C>());
+    }
+
+    FlatSet(const Less& less) : Collection<C>(), less(less) {
+        this->entries.push_back(FlatSetNode<C>());
+    }
+
+    ~FlatSet() override {
+        // The Collection base class will handle data deletion if it's owned
+    }
+
+    // Get the size of the set
+    int getSize() const {
+        return this->size;
+    }
+
+    // Get the first (smallest) entry, or nullptr when the set is empty
+    FlatSetNode<C>* head() const {
+        if (this->size == 0) {
+            return nullptr;
+        }
+        return const_cast<FlatSetNode<C>*>(&this->entries[0]);
+    }
+
+    // Get the last (largest) entry, or nullptr when the set is empty
+    FlatSetNode<C>* tail() const {
+        if (this->size == 0) {
+            return nullptr;
+        }
+        return const_cast<FlatSetNode<C>*>(&this->entries[this->size - 1]);
+    }
+
+    // Check if an element is in the set (binary search)
+    bool isMember(const C* data) const {
+        if (data == nullptr) {
+            return false;
+        }
+
+        size_t i = this->lowerBound(data, 0);
+        return i < static_cast<size_t>(this->size) && !this->less(*data, *this->entries[i].data());
+    }
+
+    // Insert an element into the set if it doesn't already exist
+    void insert(C* data, bool takeOwnership = false) {
+        if (data == nullptr) {
+            return;
+        }
+
+        size_t i = this->lowerBound(data, 0);
+        if (i < static_cast<size_t>(this->size) && !this->less(*data, *this->entries[i].data())) {
+            return;  // Already a member
+        }
+
+        this->entries.insert(this->entries.begin() + i, FlatSetNode<C>(data));
+        if constexpr (UsesKernels) {
+            this->keys.insert(this->keys.begin() + i, *data);
+        }
+
+        // Take ownership if requested
+        if (takeOwnership) {
+            this->takeOwnership(data);
+        }
+
+        this->size++;
+    }
+
+    // Remove an element from the set
+    bool remove(C* data) {
+        if (data == nullptr) {
+            return false;
+        }
+
+        size_t i = this->lowerBound(data, 0);
+        if (i == static_cast<size_t>(this->size) || this->less(*data, *this->entries[i].data())) {
+            return false;
+        }
+
+        C* removed = this->entries[i].data();
+        this->entries.erase(this->entries.begin() + i);
+        if constexpr (UsesKernels) {
+            this->keys.erase(this->keys.begin() + i);
+        }
+        this->size--;
+
+        // Release ownership if we owned the data
+        if (this->hasOwnership(removed)) {
+            this->releaseOwnership(removed);
+        }
+
+        return true;
+    }
+
+    // Set operations
+    static void unionSet(FlatSet<C, Less>* result, const FlatSet<C, Less>* set1, const FlatSet<C, Less>* set2) {
+        std::vector<C*> merged;
+        merged.reserve(set1->size + set2->size);
+
+        size_t i = 0;
+        size_t j = 0;
+        size_t n = static_cast<size_t>(set1->size);
+        size_t m = static_cast<size_t>(set2->size);
+        while (i < n && j < m) {
+            C* a = set1->entries[i].data();
+            C* b = set2->entries[j].data();
+            if (set1->less(*a, *b)) {
+                merged.push_back(a);
+                i++;
+            } else if (set1->less(*b, *a)) {
+                merged.push_back(b);
+                j++;
+            } else {
+                // Elements from set1 win, as in Set::unionSet
+                merged.push_back(a);
+                i++;
+                j++;
+            }
+        }
+        for (; i < n; i++) {
+            merged.push_back(set1->entries[i].data());
+        }
+        for (; j < m; j++) {
+            merged.push_back(set2->entries[j].data());
+        }
+
+        result->mergeSorted(merged);
+    }
+
+    static void intersectionSet(FlatSet<C, Less>* result, const FlatSet<C, Less>* set1, const FlatSet<C, Less>* set2) {
+        result->mergeSorted(filter(set1, set2, true));
+    }
+
+    static void differenceSet(FlatSet<C, Less>* result, const FlatSet<C, Less>* set1, const FlatSet<C, Less>* set2) {
+        result->mergeSorted(filter(set1, set2, false));
+    }
+
+    static bool isSubset(const FlatSet<C, Less>* set1, const FlatSet<C, Less>* set2) {
+        // If set1 is larger than set2, it can't be a subset
+        if (set1->size > set2->size) {
+            return false;
+        }
+
+        if constexpr (UsesKernels) {
+            // Every member of set1 has to be found in set2
+            size_t n = static_cast<size_t>(set1->size);
+            size_t m = static_cast<size_t>(set2->size);
+            if (m <= n * gallopRatio) {
+                return sortedIntersectCount(set1->keys.data(), n, set2->keys.data(), m) == n;
+            }
+        }
+
+        return filter(set1, set2, false).empty();
+    }
+
+    static bool isEqualSet(const FlatSet<C, Less>* set1, const FlatSet<C, Less>* set2) {
+        if (set1->size != set2->size) {
+            return false;
+        }
+
+        if constexpr (UsesKernels) {
+            return set1->keys == set2->keys;
+        }
+
+        // Equal sets have equivalent members at every position
+        for (int i = 0; i < set1->size; i++) {
+            if (!set1->equivalent(set1->entries[i].data(), set2->entries[i].data())) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+#endif // FLATSET_H
@@ -6,29 +6,106 @@
 #include "adjacentlist.h"
 #include "bfsvertex.h"
 #include "collection.h"
-
-template <class C, class Compare = std::equal_to<C>> class Graph : public Collection<C, Compare>
+#include "hashindex.h"
+
+// Graph stored as a list of adjacency lists, one per vertex.
+//
+// Vertices are looked up by value with Compare. When a Hash functor
+// consistent with Compare is supplied (equal vertices must hash equal),
+// the graph keeps a hash index from vertex key to its adjacency list node
+// and every lookup is O(1) on average. With the default NoHash the graph
+// scans the adjacency lists instead, which works with any Compare.
+//
+// AdjacentSet is the neighbour set type of each vertex, Set by default. A
+// FlatSet keeps the neighbours sorted by its Less functor, which must order
+// vertices consistently with Compare.
+//
+// Every vertex also records the vertices with an edge to it, so removing a
+// vertex never scans the other adjacency lists: removeVertex checks its
+// in-degree in O(1) and removeVertexCascade drops it together with all its
+// edges in O(degree) on a hashed graph.
+//
+// Edges can carry a double weight, given to insertWeightedEdge. Edges
+// inserted with insertEdge weigh 1.
+template <class C, class Compare = std::equal_to<C>, class Hash = NoHash<C>, class AdjacentSet = Set<C, Compare, Hash>>
+class Graph : public Collection<C, Compare>
 {
 private:
+    // Key extractor for the vertex index
+    struct VertexKey {
+        C* operator()(const ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>* node) const {
+            return node->data()->vertex;
+        }
+    };
+
     int vcount;
     int ecount;
+    HashIndex<ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>, C, Hash, Compare, VertexKey> vertexIndex;
+
+    // Find the adjacency list node of the vertex equal to data
+    ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>* lookupVertex(const C* data) const {
+        if (data == nullptr) {
+            return nullptr;
+        }
+
+        if constexpr (IsHashed<C, Hash>::value) {
+            return this->vertexIndex.find(data);
+        } else {
+            ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>* node;
+
+            for (node = this->adjacentLists.head(); node != nullptr; node = node->next()) {
+                if (node->data() != nullptr && node->data()->vertex != nullptr) {
+                    if (this->equalTo(*data, *(node->data()->vertex))) {
+                        return node;
+                    }
+                }
+            }
+
+            return nullptr;
+        }
+    }
+
+    // Unlink the adjacency list node of a vertex, keeping the previous
+    // node links in step, and return its adjacency list
+    AdjacentList<C, Compare, Hash, AdjacentSet>* unlinkVertex(ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>* node) {
+        AdjacentList<C, Compare, Hash, AdjacentSet>* adjList = nullptr;
+        ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>* prev = node->data()->previous;
+
+        if (node->next() != nullptr) {
+            node->next()->data()->previous = prev;
+        }
+
+        if constexpr (IsHashed<C, Hash>::value) {
+            this->vertexIndex.remove(node);
+        }
+
+        // prev is nullptr for the head node, which removeUnchecked removes
+        this->adjacentLists.removeUnchecked(prev, &adjList);
+        this->vcount--;
+        return adjList;
+    }
 protected:
-    List<AdjacentList<C, Compare>> adjacentLists;
+    List<AdjacentList<C, Compare, Hash, AdjacentSet>> adjacentLists;
 public:
     Graph() : Collection<C, Compare>() {
         this->vcount = 0;
         this->ecount = 0;
     }
 
-    Graph(const Compare &comp) : Collection<C, Compare>(comp) {
+    Graph(const Compare &comp) : Collection<C, Compare>(comp), vertexIndex(comp) {
+        this->vcount = 0;
+        this->ecount = 0;
+    }
+
+    Graph(const Compare &comp, const Hash &hash) : Collection<C, Compare>(comp), vertexIndex(comp, hash) {
         this->vcount = 0;
         this->ecount = 0;
     }
     
     ~Graph() override {
-        AdjacentList<C, Compare>* adjList;
+        AdjacentList<C, Compare, Hash, AdjacentSet>* adjList;
         while(this->adjacentLists.getSize() > 0) {
-            this->adjacentLists.remove(nullptr, &adjList);
+            this->adjacentLists.removeUnchecked(nullptr, &adjList);
             // The vertex pointer in the adjacentList will be deleted by Collection if we own it
             delete adjList;
         }
@@ -36,24 +113,22 @@ public:
     }
 
     int insertVertex(C* data, bool takeOwnership = false) {
-        ListNode<AdjacentList<C, Compare>>* node;
-        AdjacentList<C, Compare>* adjList = new AdjacentList<C, Compare>();
-
         // Check if the vertex already exists
-        for (node = this->adjacentLists.head(); node != nullptr; node = node->next()) {
-            if (data != nullptr && node->data() != nullptr) {
-                if (this->equalTo(*data, *(node->data()->vertex))) {
-                    delete adjList; // Prevent memory leak
-                    return 1; // Duplicate found, do not insert
-                }
-            }
+        if (this->lookupVertex(data) != nullptr) {
+            return 1; // Duplicate found, do not insert
         }
         
         // Store the vertex in the adjacent list
+        AdjacentList<C, Compare, Hash, AdjacentSet>* adjList = new AdjacentList<C, Compare, Hash, AdjacentSet>();
         adjList->vertex = data;
+        adjList->previous = this->adjacentLists.tail();
         
         // Add the adjacent list to our collection
-        this->adjacentLists.insert(this->adjacentLists.tail(), adjList);
+        this->adjacentLists.insertUnchecked(this->adjacentLists.tail(), adjList);
+
+        if constexpr (IsHashed<C, Hash>::value) {
+            this->vertexIndex.insert(this->adjacentLists.tail());
+        }
         
         // Take ownership of the vertex data if requested
         if (takeOwnership && data != nullptr) {
@@ -65,36 +140,40 @@ public:
     }
 
     int insertEdge(C* data1, C* data2, bool takeOwnership = false) {
-        ListNode<AdjacentList<C, Compare>>* node;
+        return this->insertWeightedEdge(data1, data2, 1.0, takeOwnership);
+    }
+
+    // Insert an edge with a weight
+    int insertWeightedEdge(C* data1, C* data2, double weight, bool takeOwnership = false) {
+        ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>* node;
+        ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>* target;
 
         // Find destination vertex
-        for (node = this->adjacentLists.head(); node != nullptr; node = node->next()) {
-            if (data2 != nullptr && node->data() != nullptr) {
-                if (this->equalTo(*data2, *(node->data()->vertex))) {
-                    break;
-                }
-            }
-        }
+        target = this->lookupVertex(data2);
 
-        if (node == nullptr) {
+        if (target == nullptr) {
             return -1;  // Destination vertex not found
         }
 
         // Find source vertex
-        for (node = this->adjacentLists.head(); node != nullptr; node = node->next()) {
-            if (data1 != nullptr && node->data() != nullptr) {
-                if (this->equalTo(*data1, *(node->data()->vertex))) {
-                    break;
-                }
-            }
-        }
+        node = this->lookupVertex(data1);
 
         if (node == nullptr) {
             return -1;  // Source vertex not found
         }
+
+        if (node->data()->adjacent.isMember(data2)) {
+            return 1;  // Edge already exists
+        }
         
-        // Insert the edge (create relationship in adjacent list)
+        // Insert the edge (create relationship in adjacent list) and
+        // record it as an incoming edge of the destination
         node->data()->adjacent.insert(data2, takeOwnership);
+        target->data()->incoming.insert(node->data()->vertex);
+
+        if (weight != 1.0) {
+            node->data()->weights[target->data()->vertex] = weight;
+        }
         
         this->ecount++;
         return 0;
@@ -105,47 +184,23 @@ public:
             return -1; // Invalid input
         }
 
-        ListNode<AdjacentList<C, Compare>>* current = nullptr;
-        ListNode<AdjacentList<C, Compare>>* prev = nullptr;
-        AdjacentList<C, Compare>* adjList = nullptr;
-        C* vertexToRemove = *data;
-        bool found = false;
+        ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>* node = this->lookupVertex(*data);
 
-        // First, check if the vertex is used in any adjacency list (incoming edges)
-        for (current = this->adjacentLists.head(); current != nullptr; current = current->next()) {
-            if (current->data()->adjacent.isMember(vertexToRemove)) {
-                return -1;  // Vertex is referenced by other vertices
-            }
-        }
-
-        // Find the vertex to remove
-        for (current = this->adjacentLists.head(); current != nullptr; current = current->next()) {
-            if (vertexToRemove != nullptr && current->data() != nullptr) {
-                if (this->equalTo(*vertexToRemove, *(current->data()->vertex))) {
-                    found = true;
-                    break;
-                }
-            }
-            prev = current;
+        if (node == nullptr) {
+            return -1;  // Vertex not found
         }
 
-        if (!found) {
-            return -1;  // Vertex not found
+        // Check if the vertex is referenced by other vertices (incoming edges)
+        if (node->data()->incoming.getSize() > 0) {
+            return -1;
         }
 
         // Check if the vertex has outgoing edges
-        if (current->data()->adjacent.getSize() > 0) {
+        if (node->data()->adjacent.getSize() > 0) {
             return -1;  // Vertex has edges, can't remove
         }
 
-        // Remove the adjacent list from our collection
-        if (prev == nullptr) {
-            // It's the head node
-            this->adjacentLists.remove(nullptr, &adjList);
-        } else {
-            // It's not the head node
-            this->adjacentLists.remove(prev, &adjList);
-        }
+        AdjacentList<C, Compare, Hash, AdjacentSet>* adjList = this->unlinkVertex(node);
 
         // Store the vertex data for the caller
         *data = adjList->vertex;
@@ -156,34 +211,77 @@ public:
         }
         
         delete adjList;
-
-        this->vcount--;
         return 0;
     }
 
-    int removeEdge(C* data1, C** data2) {
-        if (data1 == nullptr || data2 == nullptr || *data2 == nullptr) {
+    // Remove a vertex together with all its incoming and outgoing edges.
+    // O(degree) when the graph is hashed, since every edge end is found
+    // through the vertex index.
+    int removeVertexCascade(C** data) {
+        if (data == nullptr || *data == nullptr) {
             return -1; // Invalid input
         }
 
-        ListNode<AdjacentList<C, Compare>>* node;
+        ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>* node = this->lookupVertex(*data);
 
-        // Find the source vertex
-        for (node = this->adjacentLists.head(); node != nullptr; node = node->next()) {
-            if (data1 != nullptr && node->data() != nullptr) {
-                if (this->equalTo(*data1, *(node->data()->vertex))) {
-                    break;
-                }
+        if (node == nullptr) {
+            return -1;  // Vertex not found
+        }
+
+        AdjacentList<C, Compare, Hash, AdjacentSet>* adjList = node->data();
+
+        // Drop the outgoing edges, including a self loop
+        while (adjList->adjacent.head() != nullptr) {
+            C* neighbour = adjList->adjacent.head()->data();
+            ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>* target = this->lookupVertex(neighbour);
+
+            if (target != nullptr) {
+                target->data()->incoming.remove(adjList->vertex);
             }
+
+            adjList->adjacent.remove(neighbour);
+            this->ecount--;
+        }
+
+        // Drop the incoming edges
+        while (adjList->incoming.head() != nullptr) {
+            C* source = adjList->incoming.head()->data();
+            ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>* sourceNode = this->lookupVertex(source);
+
+            if (sourceNode != nullptr) {
+                sourceNode->data()->adjacent.remove(adjList->vertex);
+                sourceNode->data()->weights.erase(adjList->vertex);
+            }
+
+            adjList->incoming.remove(source);
+            this->ecount--;
         }
 
+        return this->removeVertex(data);
+    }
+
+    int removeEdge(C* data1, C** data2) {
+        if (data1 == nullptr || data2 == nullptr || *data2 == nullptr) {
+            return -1; // Invalid input
+        }
+
+        // Find the source vertex
+        ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>* node = this->lookupVertex(data1);
+
         if (node == nullptr) {
             return -1;  // Source vertex not found
         }
 
         // The Set::remove method returns true if the element was found and removed
         if (node->data()->adjacent.remove(*data2)) {
-            // Successfully removed
+            // Successfully removed, drop the matching incoming edge
+            ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>* target = this->lookupVertex(*data2);
+
+            if (target != nullptr) {
+                target->data()->incoming.remove(node->data()->vertex);
+                node->data()->weights.erase(target->data()->vertex);
+            }
+
             this->ecount--;
             return 0;
         } else {
@@ -192,18 +290,8 @@ public:
         }
     }
 
-    int buildAdjacentList(C* data, AdjacentList<C, Compare>** adjList) {
-        ListNode<AdjacentList<C, Compare>>* node;
-        ListNode<AdjacentList<C, Compare>>* prev = nullptr;
-
-        for (node = this->adjacentLists.head(); node != nullptr; node = node->next()) {
-            if (data != nullptr && node->data() != nullptr) {
-                if (this->equalTo(*data, *(node->data()->vertex))) {
-                    break;
-                }
-            }
-            prev = node;
-        }
+    int buildAdjacentList(C* data, AdjacentList<C, Compare, Hash, AdjacentSet>** adjList) {
+        ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>* node = this->lookupVertex(data);
 
         if (node == nullptr) {
             return -1;
@@ -213,19 +301,24 @@ public:
         return 0;
     }
 
-    bool isAdjacentGraph(C* data1, C* data2) {
-        ListNode<AdjacentList<C, Compare>>* node;
-        ListNode<AdjacentList<C, Compare>>* prev = nullptr;
+    // Weight of the edge from data1 to data2. Returns -1 when there is no
+    // such edge.
+    int getEdgeWeight(const C* data1, const C* data2, double* weight) const {
+        ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>* node = this->lookupVertex(data1);
+        ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>* target = this->lookupVertex(data2);
 
-        for (node = this->adjacentLists.head(); node != nullptr; node = node->next()) {
-            if (data1 != nullptr && node->data() != nullptr) {
-                if (this->equalTo(*data1, *(node->data()->vertex))) {
-                    break;
-                }
-            }
-            prev = node;
+        if (node == nullptr || target == nullptr || weight == nullptr ||
+            !node->data()->adjacent.isMember(target->data()->vertex)) {
+            return -1;
         }
 
+        *weight = node->data()->getWeight(target->data()->vertex);
+        return 0;
+    }
+
+    bool isAdjacentGraph(C* data1, C* data2) {
+        ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>* node = this->lookupVertex(data1);
+
         if (node == nullptr) {
             return false;
         }
@@ -241,22 +334,18 @@ public:
         return this->ecount;
     }
 
-    ListNode<AdjacentList<C, Compare>>* findNodeByVertex(C* data) {
-        ListNode<AdjacentList<C, Compare>>* node;
-        
-        for (node = this->adjacentLists.head(); node != nullptr; node = node->next()) {
-            if (data != nullptr && node->data() != nullptr) {
-                if (this->equalTo(*data, *(node->data()->vertex))) {
-                    return node;
-                }
-            }
-        }
-        
-        return nullptr;
+    // Number of edges pointing to a vertex, or -1 if it is not in the graph
+    int getInDegree(const C* data) const {
+        ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>* node = this->lookupVertex(data);
+        return node == nullptr ? -1 : node->data()->incoming.getSize();
+    }
+
+    ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>* findNodeByVertex(const C* data) const {
+        return this->lookupVertex(data);
     }
     
     // Getter for adjacentLists, returns the head node of the list
-    ListNode<AdjacentList<C, Compare>>* getAdjacencyListHead() const {
+    ListNode<AdjacentList<C, Compare, Hash, AdjacentSet>>* getAdjacencyListHead() const {
         return this->adjacentLists.head();
     }
     
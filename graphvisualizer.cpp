@@ -189,8 +189,11 @@ void GraphVisualizer::removeVertex(VisualVertex* vertex) {
     // Remove from visual list first
     vertices.removeOne(vertex);
     
-    // Remove from graph - this will also delete the vertex since graph has ownership
-    graph.removeVertex(&vertex);
+    // Remove from graph together with its edges. The graph releases its
+    // ownership of a removed vertex instead of deleting it, so delete it here
+    if (graph.removeVertexCascade(&vertex) == 0) {
+        delete vertex;
+    }
     
     // Process pending deletions
     QApplication::processEvents();
@@ -409,6 +412,13 @@ struct DfsVisualVertexCompare {
     }
 };
 
+// Custom hash for DfsVisualVertex, consistent with DfsVisualVertexCompare
+struct DfsVisualVertexHash {
+    size_t operator()(const DfsVisualVertex& v) const {
+        return v.data ? std::hash<int>()(v.data->value) : 0;
+    }
+};
+
 void GraphVisualizer::startDfsAnimation()
 {
     // Reset any previous DFS state
@@ -421,7 +431,7 @@ void GraphVisualizer::startDfsAnimation()
     dfsAnimationStep = DfsRunning;
     
     // Create a Graph with DfsVisualVertex wrappers
-    Graph<DfsVisualVertex, DfsVisualVertexCompare> dfsGraph;
+    Graph<DfsVisualVertex, DfsVisualVertexCompare, DfsVisualVertexHash> dfsGraph;
     
     // Create a map to keep track of the wrapper vertices
     QMap<int, DfsVisualVertex*> dfsVertices;
@@ -476,12 +486,24 @@ void GraphVisualizer::startDfsAnimation()
     
     qDebug() << "DFS Lists match:" << listsMatch;
     
+    // The finish order is only a topological order when there is no cycle,
+    // which Kahn's sort detects by leaving vertices without a level
+    TopologicalOrder levels;
+    bool acyclic = topologicalSort(&dfsGraph, levels) == 0;
+    
     // Update the label to show the ordered list
     // (Label is created in the constructor and always visible)
     
     // Update the label with the ordered list
     QString orderText = "<b>DFS Order:</b><br>";
-    orderText += "<i>(Topological sort - reading from bottom to top)</i><br><br>";
+    if (acyclic) {
+        orderText += "<i>(Topological sort - reading from bottom to top)</i><br><br>";
+    } else {
+        orderText += QString("<i>(No topological sort: %1 of %2 vertices<br>"
+                             "are on a cycle or reached from one)</i><br><br>")
+                         .arg(dfsOrderedList.size() - static_cast<int>(levels.order.size()))
+                         .arg(dfsOrderedList.size());
+    }
     
     // Display in reverse order for proper topological sort
     // A topological sort means: if there's an edge from A to B, A comes before B
@@ -16,6 +16,7 @@
 #include "bfs.h"
 #include "dfsvertex.h"
 #include "dfs.h"
+#include "topologicalsort.h"
 
 // Utility function to convert VertexColor enum to QColor
 inline QColor vertexColorToQColor(VertexColor color) {
@@ -76,6 +77,13 @@ struct VisualVertexCompare {
     }
 };
 
+// Hash for VisualVertex, consistent with VisualVertexCompare
+struct VisualVertexHash {
+    size_t operator()(const VisualVertex& v) const {
+        return std::hash<int>()(v.value);
+    }
+};
+
 class GraphVisualizer : public QObject {
     Q_OBJECT
 public:
@@ -140,7 +148,7 @@ private slots:
     
 private:
     QWidget* area;
-    Graph<VisualVertex, VisualVertexCompare> graph;
+    Graph<VisualVertex, VisualVertexCompare, VisualVertexHash> graph;
     QList<VisualVertex*> vertices;
     QList<Line*> lines;
     
@@ -0,0 +1,223 @@
+#ifndef HASHINDEX_H
+#define HASHINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @struct NoHash
+ * @brief Marker used as the default Hash parameter of the collections
+ *
+ * A collection instantiated with NoHash keeps no hash index and finds
+ * elements by scanning them with its Compare functor, exactly as before
+ * hashing was added. This is required for Compare functors that cannot be
+ * expressed as a hash, such as approximate or threshold comparisons.
+ */
+template<class C> struct NoHash
+{
+};
+
+/**
+ * @brief Check whether a Hash parameter enables hash indexing
+ */
+template<class C, class Hash> struct IsHashed
+    : std::integral_constant<bool, !std::is_same<Hash, NoHash<C>>::value>
+{
+};
+
+/**
+ * @class HashIndex
+ * @brief Open-addressing hash index from element keys to entries of a collection
+ *
+ * The index stores pointers to entries of type E (for example list nodes)
+ * and finds them by the value of their key, obtained with the KeyOf functor.
+ * Hash must be consistent with Compare: keys that compare equal must have
+ * the same hash. Collisions are resolved with linear probing, each bucket
+ * caches its full hash so probing and rehashing never call Hash again, and
+ * removal uses backward shift deletion so there are no tombstones.
+ *
+ * Entries with a nullptr key are never indexed.
+ */
+template<class E, class C, class Hash, class Compare, class KeyOf> class HashIndex
+{
+private:
+    struct Bucket {
+        E* entry;      // Indexed entry, nullptr marks an empty bucket
+        size_t hash;   // Cached hash of the entry's key
+    };
+
+    Bucket* buckets;   // Bucket array
+    size_t capacity;   // Number of buckets, always zero or a power of two
+    size_t count;      // Number of indexed entries
+    Hash hasher;
+    Compare equalTo;
+    KeyOf keyOf;
+
+    static const size_t minCapacity = 16;
+
+    // Mix the user hash so that weak hashes (e.g. identity on integers)
+    // still spread over the table
+    size_t hashOf(const C* key) const {
+        uint64_t h = static_cast<uint64_t>(this->hasher(*key));
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        return static_cast<size_t>(h);
+    }
+
+    size_t homeBucket(size_t hash) const {
+        return hash & (this->capacity - 1);
+    }
+
+    // Find the bucket holding an entry whose key equals key
+    size_t findBucket(const C* key) const {
+        if (this->count == 0 || key == nullptr) {
+            return this->capacity;
+        }
+
+        size_t hash = this->hashOf(key);
+        size_t mask = this->capacity - 1;
+        for (size_t i = this->homeBucket(hash); this->buckets[i].entry != nullptr; i = (i + 1) & mask) {
+            if (this->buckets[i].hash == hash && this->equalTo(*key, *this->keyOf(this->buckets[i].entry))) {
+                return i;
+            }
+        }
+
+        return this->capacity;
+    }
+
+    void rehash(size_t newCapacity) {
+        Bucket* oldBuckets = this->buckets;
+        size_t oldCapacity = this->capacity;
+
+        this->buckets = new Bucket[newCapacity]();
+        this->capacity = newCapacity;
+
+        size_t mask = newCapacity - 1;
+        for (size_t i = 0; i < oldCapacity; i++) {
+            if (oldBuckets[i].entry != nullptr) {
+                size_t j = this->homeBucket(oldBuckets[i].hash);
+                while (this->buckets[j].entry != nullptr) {
+                    j = (j + 1) & mask;
+                }
+                this->buckets[j] = oldBuckets[i];
+            }
+        }
+
+        delete[] oldBuckets;
+    }
+
+    // Empty bucket hole, shifting later members of its probe chain back
+    void eraseBucket(size_t hole) {
+        size_t mask = this->capacity - 1;
+        size_t i = hole;
+        while (true) {
+            i = (i + 1) & mask;
+            if (this->buckets[i].entry == nullptr) {
+                break;
+            }
+
+            size_t home = this->homeBucket(this->buckets[i].hash);
+            if (((i - home) & mask) >= ((i - hole) & mask)) {
+                this->buckets[hole] = this->buckets[i];
+                hole = i;
+            }
+        }
+
+        this->buckets[hole].entry = nullptr;
+        this->count--;
+    }
+
+public:
+    HashIndex(const Compare& comp = Compare(), const Hash& hash = Hash())
+        : buckets(nullptr), capacity(0), count(0), hasher(hash), equalTo(comp) {
+    }
+
+    ~HashIndex() {
+        delete[] this->buckets;
+    }
+
+    // The index owns its bucket array, so it cannot be shallow copied
+    HashIndex(const HashIndex&) = delete;
+    HashIndex& operator=(const HashIndex&) = delete;
+
+    /**
+     * @brief Index an entry by its key
+     * @param entry The entry to add
+     * @return true if added, false if the key is nullptr or an equal key is already indexed
+     */
+    bool insert(E* entry) {
+        const C* key = this->keyOf(entry);
+        if (key == nullptr) {
+            return false;
+        }
+
+        // Keep the load factor at or below 1/2 so probe chains stay short
+        if (this->capacity == 0) {
+            this->rehash(minCapacity);
+        } else if ((this->count + 1) * 2 > this->capacity) {
+            this->rehash(this->capacity * 2);
+        }
+
+        size_t hash = this->hashOf(key);
+        size_t mask = this->capacity - 1;
+        size_t i = this->homeBucket(hash);
+        while (this->buckets[i].entry != nullptr) {
+            if (this->buckets[i].hash == hash && this->equalTo(*key, *this->keyOf(this->buckets[i].entry))) {
+                return false;
+            }
+            i = (i + 1) & mask;
+        }
+
+        this->buckets[i].entry = entry;
+        this->buckets[i].hash = hash;
+        this->count++;
+        return true;
+    }
+
+    /**
+     * @brief Remove an entry from the index
+     * @param entry The entry to remove (matched by identity)
+     * @return true if the entry was indexed and has been removed
+     */
+    bool remove(const E* entry) {
+        const C* key = this->keyOf(entry);
+        if (this->count == 0 || key == nullptr) {
+            return false;
+        }
+
+        size_t mask = this->capacity - 1;
+        for (size_t i = this->homeBucket(this->hashOf(key)); this->buckets[i].entry != nullptr; i = (i + 1) & mask) {
+            if (this->buckets[i].entry == entry) {
+                this->eraseBucket(i);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Find the entry whose key equals key
+     * @param key The key to look for
+     * @return The entry, or nullptr if no entry has an equal key
+     */
+    E* find(const C* key) const {
+        size_t i = this->findBucket(key);
+        return i == this->capacity ? nullptr : this->buckets[i].entry;
+    }
+
+    size_t getSize() const {
+        return this->count;
+    }
+
+    void clear() {
+        delete[] this->buckets;
+        this->buckets = nullptr;
+        this->capacity = 0;
+        this->count = 0;
+    }
+};
+
+#endif // HASHINDEX_H
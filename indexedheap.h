@@ -0,0 +1,199 @@
+#ifndef INDEXEDHEAP_H
+#define INDEXEDHEAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class IndexedHeap
+ * @brief Min-priority queue of the integers 0 .. capacity - 1 with decrease-key
+ *
+ * Each index is in the heap at most once, with a priority. The heap is a
+ * complete Arity-ary tree stored in a contiguous array of (priority, index)
+ * entries, and a position array records where each index sits, so
+ * contains, getPriority and decreaseKey find an entry in O(1) instead of
+ * searching for it. push and decreaseKey are O(log n / log Arity), pop is
+ * O(Arity log n / log Arity).
+ *
+ * A wider tree is shallower, so decrease-key, the common operation of
+ * Dijkstra on sparse graphs, moves an entry up fewer levels, and the
+ * children compared by pop are adjacent in memory. 4 is a good default.
+ *
+ * Like DisjointSet the elements are plain indices such as CsrGraph vertex
+ * IDs, so the heap owns nothing.
+ */
+template<class Priority = double, unsigned Arity = 4> class IndexedHeap
+{
+    static_assert(Arity >= 2, "IndexedHeap needs at least two children per node");
+
+private:
+    struct Entry {
+        Priority priority;
+        uint32_t index;
+    };
+
+    std::vector<Entry> entries;       // Heap order, the minimum first
+    std::vector<uint32_t> positions;  // Slot of each index in entries, or npos
+
+    void place(size_t slot, const Entry& entry) {
+        this->entries[slot] = entry;
+        this->positions[entry.index] = static_cast<uint32_t>(slot);
+    }
+
+    // Move the entry in slot towards the root while it beats its parent
+    void siftUp(size_t slot) {
+        Entry entry = this->entries[slot];
+
+        while (slot > 0) {
+            size_t parent = (slot - 1) / Arity;
+            if (!(entry.priority < this->entries[parent].priority)) {
+                break;
+            }
+            this->place(slot, this->entries[parent]);
+            slot = parent;
+        }
+
+        this->place(slot, entry);
+    }
+
+    // Move the entry in slot towards the leaves while a child beats it
+    void siftDown(size_t slot) {
+        Entry entry = this->entries[slot];
+        size_t count = this->entries.size();
+
+        while (true) {
+            size_t first = slot * Arity + 1;
+            if (first >= count) {
+                break;
+            }
+
+            size_t last = first + Arity < count ? first + Arity : count;
+            size_t best = first;
+            for (size_t child = first + 1; child < last; child++) {
+                if (this->entries[child].priority < this->entries[best].priority) {
+                    best = child;
+                }
+            }
+
+            if (!(this->entries[best].priority < entry.priority)) {
+                break;
+            }
+            this->place(slot, this->entries[best]);
+            slot = best;
+        }
+
+        this->place(slot, entry);
+    }
+
+public:
+    static constexpr uint32_t npos = UINT32_MAX;
+
+    explicit IndexedHeap(uint32_t capacity = 0) {
+        this->reset(capacity);
+    }
+
+    // Empty the heap and accept the indices 0 .. capacity - 1
+    void reset(uint32_t capacity) {
+        this->entries.clear();
+        this->positions.assign(capacity, npos);
+    }
+
+    uint32_t getCapacity() const {
+        return static_cast<uint32_t>(this->positions.size());
+    }
+
+    int getSize() const {
+        return static_cast<int>(this->entries.size());
+    }
+
+    bool isEmpty() const {
+        return this->entries.empty();
+    }
+
+    bool contains(uint32_t index) const {
+        return index < this->positions.size() && this->positions[index] != npos;
+    }
+
+    // Priority of an index in the heap
+    Priority getPriority(uint32_t index) const {
+        return this->entries[this->positions[index]].priority;
+    }
+
+    /**
+     * @brief Add an index with a priority
+     * @return 0 if added, 1 if the index is already in the heap (its
+     * priority is left alone), -1 if it is out of range
+     */
+    int push(uint32_t index, Priority priority) {
+        if (index >= this->positions.size()) {
+            return -1;
+        }
+        if (this->positions[index] != npos) {
+            return 1;
+        }
+
+        this->entries.push_back(Entry{priority, index});
+        this->siftUp(this->entries.size() - 1);
+        return 0;
+    }
+
+    /**
+     * @brief Lower the priority of an index in the heap
+     * @return 0 if lowered, 1 if priority is not lower than the current
+     * one, -1 if the index is not in the heap
+     */
+    int decreaseKey(uint32_t index, Priority priority) {
+        if (!this->contains(index)) {
+            return -1;
+        }
+
+        size_t slot = this->positions[index];
+        if (!(priority < this->entries[slot].priority)) {
+            return 1;
+        }
+
+        this->entries[slot].priority = priority;
+        this->siftUp(slot);
+        return 0;
+    }
+
+    // Index with the lowest priority; the heap must not be empty
+    uint32_t top() const {
+        return this->entries.front().index;
+    }
+
+    Priority topPriority() const {
+        return this->entries.front().priority;
+    }
+
+    /**
+     * @brief Remove the index with the lowest priority
+     * @return 0, or -1 if the heap is empty. index and priority may be nullptr.
+     */
+    int pop(uint32_t* index, Priority* priority = nullptr) {
+        if (this->entries.empty()) {
+            return -1;
+        }
+
+        const Entry& front = this->entries.front();
+        if (index != nullptr) {
+            *index = front.index;
+        }
+        if (priority != nullptr) {
+            *priority = front.priority;
+        }
+        this->positions[front.index] = npos;
+
+        Entry last = this->entries.back();
+        this->entries.pop_back();
+        if (!this->entries.empty()) {
+            this->entries.front() = last;
+            this->siftDown(0);
+        }
+
+        return 0;
+    }
+};
+
+#endif // INDEXEDHEAP_H
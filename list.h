@@ -3,12 +3,15 @@
 
 #include "listnode.h"
 #include "collection.h"
+#include "nodepool.h"
 
-template<class C, class Compare = std::equal_to<C>> class List : public Collection<C, Compare>
+template<class C, class Compare = std::equal_to<C>, template<class> class Allocator = PoolAllocator>
+class List : public Collection<C, Compare>
 {
 private:
     ListNode<C>* h;  // Head pointer
     ListNode<C>* t;  // Tail pointer
+    Allocator<ListNode<C>> nodes;  // Node allocator, reuses freed nodes
 public:
     List() : Collection<C, Compare>() {
         this->h = nullptr;
@@ -38,34 +41,27 @@ public:
     }
 
     void insert(ListNode<C>* node, C* data, bool takeOwnership = false) {
+        // If node isn't in list, treat as null (insert at head)
+        if (node != nullptr && !this->contains(node)) {
+            node = nullptr;
+        }
+
+        this->insertUnchecked(node, data, takeOwnership);
+    }
+
+    // Trusted insert: skips the O(n) check that node belongs to this list.
+    // The caller guarantees node is nullptr (insert at head) or one of our
+    // own nodes, e.g. the value of tail() or a node reached from head().
+    void insertUnchecked(ListNode<C>* node, C* data, bool takeOwnership = false) {
         // Don't insert null data
         if (data == nullptr) {
             return;
         }
         
         // Create the new node
-        ListNode<C>* newNode = new ListNode<C>();
+        ListNode<C>* newNode = this->nodes.allocate();
         newNode->setData(data);
         
-        // Check if node is a valid node in our list
-        if (node != nullptr) {
-            bool nodeFound = false;
-            ListNode<C>* current = this->h;
-            
-            while (current != nullptr) {
-                if (current == node) {
-                    nodeFound = true;
-                    break;
-                }
-                current = current->next();
-            }
-            
-            // If node isn't in list, treat as null (insert at head)
-            if (!nodeFound) {
-                node = nullptr;
-            }
-        }
-        
         // Now handle insertion
         if (node == nullptr) {
             // Insert at the head
@@ -94,34 +90,28 @@ public:
     }
 
     void remove(ListNode<C>* node, C** data) {
-        // Add null checks and empty list checks
-        if (this->h == nullptr || this->size == 0) {
+        // If removing a specific node, validate it exists in the list
+        if (node != nullptr && !this->contains(node)) {
+            // Node not in list - either handle as error or set data to null and return
             if (data != nullptr) {
                 *data = nullptr;
             }
             return;
         }
-        
-        // If removing a specific node, validate it exists in the list
-        if (node != nullptr) {
-            bool nodeFound = false;
-            ListNode<C>* current = this->h;
-            
-            while (current != nullptr) {
-                if (current == node) {
-                    nodeFound = true;
-                    break;
-                }
-                current = current->next();
-            }
-            
-            if (!nodeFound) {
-                // Node not in list - either handle as error or set data to null and return
-                if (data != nullptr) {
-                    *data = nullptr;
-                }
-                return;
+
+        this->removeUnchecked(node, data);
+    }
+
+    // Trusted remove: skips the O(n) check that node belongs to this list.
+    // The caller guarantees node is nullptr (remove the head) or one of our
+    // own nodes, in which case the node after it is removed.
+    void removeUnchecked(ListNode<C>* node, C** data) {
+        // Add null checks and empty list checks
+        if (this->h == nullptr || this->size == 0) {
+            if (data != nullptr) {
+                *data = nullptr;
             }
+            return;
         }
 
         ListNode<C>* oldNode;
@@ -167,10 +157,30 @@ public:
             this->releaseOwnership(removedData);
         }
 
-        delete oldNode;
+        this->nodes.deallocate(oldNode);
         this->size--;
     }
 
+    // Check if node is one of the nodes of this list (O(n) scan)
+    bool contains(const ListNode<C>* node) const {
+        if (node == nullptr) {
+            return false;
+        }
+
+        // The tail is checked first so appends validate in O(1)
+        if (node == this->t) {
+            return true;
+        }
+
+        for (ListNode<C>* current = this->h; current != nullptr; current = current->next()) {
+            if (current == node) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
     void setHead(ListNode<C>* h) {
         this->h = h;
     }
@@ -11,7 +11,7 @@ public:
     ListNode() {
         n = nullptr;
     }
-    ListNode<C>* next() {
+    ListNode<C>* next() const {
         return n;
     }
     void setNext(ListNode<C>* n) {
@@ -0,0 +1,149 @@
+#ifndef MULTISOURCEBFS_H
+#define MULTISOURCEBFS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "csrgraph.h"
+
+// Number of sources searched together, one bit of a uint64_t each
+static const size_t multiSourceBfsLanes = 64;
+
+/**
+ * @struct HopMatrix
+ * @brief Hops from each of several sources to every vertex of a CsrGraph
+ *
+ * Row s holds the hops from sources[s], indexed by vertex ID, with -1 for
+ * vertices that source cannot reach.
+ */
+struct HopMatrix
+{
+    size_t sourceCount;
+    uint32_t vertexCount;
+    std::vector<int> hops;
+
+    HopMatrix() : sourceCount(0), vertexCount(0) {
+    }
+
+    int getHops(size_t source, uint32_t id) const {
+        return this->hops[source * this->vertexCount + id];
+    }
+};
+
+// Multi-source breadth-first search (MS-BFS, Then et al.). Searches from
+// every vertex ID in sources and calls visit(s, id, hops) once for each
+// vertex id that sources[s] reaches, level by level, starting with
+// visit(s, sources[s], 0).
+//
+// The sources are processed in batches of 64. Every vertex keeps one bit
+// per source of the batch for "seen" and for "in the frontier", so a
+// vertex reached by several sources at the same level has its edges
+// scanned once for all of them, and a whole level of a batch costs one
+// pass over the edges of the vertices in any of the 64 frontiers.
+template<typename T, typename Visitor>
+int multiSourceBfs(const CsrGraph<T>* graph,
+                   const std::vector<uint32_t>& sources,
+                   Visitor visit) {
+
+    if (!graph) {
+        return -1; // Invalid parameters
+    }
+
+    uint32_t vertexCount = static_cast<uint32_t>(graph->getVertexCount());
+    for (uint32_t source : sources) {
+        if (source >= vertexCount) {
+            return -1;  // Starting vertex not found
+        }
+    }
+
+    std::vector<uint64_t> seen(vertexCount);
+    std::vector<uint64_t> frontier(vertexCount);
+    std::vector<uint64_t> next(vertexCount);
+    std::vector<uint32_t> active;   // Vertices with frontier bits set
+    std::vector<uint32_t> touched;  // Vertices with next bits set
+
+    for (size_t batch = 0; batch < sources.size(); batch += multiSourceBfsLanes) {
+        size_t lanes = std::min(multiSourceBfsLanes, sources.size() - batch);
+        std::fill(seen.begin(), seen.end(), 0);
+        active.clear();
+
+        for (size_t lane = 0; lane < lanes; lane++) {
+            uint32_t source = sources[batch + lane];
+            uint64_t bit = uint64_t(1) << lane;
+
+            if (frontier[source] == 0) {
+                active.push_back(source);
+            }
+            frontier[source] |= bit;
+            seen[source] |= bit;
+            visit(batch + lane, source, 0);
+        }
+
+        for (int level = 0; !active.empty(); level++) {
+            touched.clear();
+
+            // One scan of each frontier vertex's edges serves all its sources
+            for (uint32_t vertex : active) {
+                uint64_t bits = frontier[vertex];
+
+                for (const uint32_t* adj = graph->adjacentBegin(vertex); adj != graph->adjacentEnd(vertex); adj++) {
+                    uint64_t fresh = bits & ~seen[*adj];
+                    if (fresh != 0) {
+                        if (next[*adj] == 0) {
+                            touched.push_back(*adj);
+                        }
+                        next[*adj] |= fresh;
+                    }
+                }
+            }
+
+            for (uint32_t vertex : active) {
+                frontier[vertex] = 0;
+            }
+            active.clear();
+
+            // seen only changes here, so next holds no bit seen before
+            for (uint32_t vertex : touched) {
+                uint64_t fresh = next[vertex];
+                next[vertex] = 0;
+                seen[vertex] |= fresh;
+                frontier[vertex] = fresh;
+                active.push_back(vertex);
+
+                while (fresh != 0) {
+                    visit(batch + __builtin_ctzll(fresh), vertex, level + 1);
+                    fresh &= fresh - 1;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+// Multi-source breadth-first search into a hop matrix with one row per
+// source. The matrix takes sources.size() * V ints; stream the results with
+// a visitor instead when that is too much.
+template<typename T>
+int multiSourceBfs(const CsrGraph<T>* graph,
+                   const std::vector<uint32_t>& sources,
+                   HopMatrix& matrix) {
+
+    if (!graph) {
+        return -1; // Invalid parameters
+    }
+
+    matrix.sourceCount = sources.size();
+    matrix.vertexCount = static_cast<uint32_t>(graph->getVertexCount());
+    matrix.hops.assign(matrix.sourceCount * matrix.vertexCount, -1);
+
+    int* hops = matrix.hops.data();
+    size_t rowLength = matrix.vertexCount;
+    return multiSourceBfs(graph, sources, [hops, rowLength](size_t source, uint32_t id, int hopCount) {
+        hops[source * rowLength + id] = hopCount;
+    });
+}
+
+#endif // MULTISOURCEBFS_H
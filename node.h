@@ -11,7 +11,7 @@ public:
         d = nullptr;
     }
 
-    C* data() {
+    C* data() const {
         return d;
     }
 
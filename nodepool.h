@@ -0,0 +1,143 @@
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <cstddef>
+#include <new>
+
+/**
+ * @class PoolAllocator
+ * @brief Slab and free-list allocator for the fixed-size nodes of a collection
+ *
+ * Nodes are carved out of slabs that are allocated from the heap in growing
+ * batches. Freed nodes go onto an intrusive free list and are handed out again
+ * by the next allocation, so once a collection has reached its working size
+ * inserting and removing elements never calls malloc. Each collection owns its
+ * own pool, and all slabs are returned to the heap when the pool is destroyed.
+ *
+ * The pool is not thread safe, in the same way the collections using it are not.
+ */
+template<class N> class PoolAllocator
+{
+private:
+    // A slot either holds a live node or, while free, the link to the next free slot
+    union Slot {
+        Slot* next;
+        alignas(N) unsigned char storage[sizeof(N)];
+    };
+
+    Slot* freeList;    // Head of the free slot list
+    Slot* slabs;       // Head of the slab list, linked through each slab's first slot
+    size_t slabSize;   // Number of node slots in the next slab
+
+    static const size_t minSlabSize = 8;
+    static const size_t maxSlabSize = 1024;
+
+    /**
+     * @brief Allocate a new slab and push its slots onto the free list
+     */
+    void grow() {
+        // Slot 0 links the slabs together so they can be freed later
+        Slot* slab = new Slot[this->slabSize + 1];
+        slab[0].next = this->slabs;
+        this->slabs = slab;
+
+        for (size_t i = this->slabSize; i >= 1; i--) {
+            slab[i].next = this->freeList;
+            this->freeList = &slab[i];
+        }
+
+        // Small collections stay small, big ones allocate less often
+        if (this->slabSize < maxSlabSize) {
+            this->slabSize *= 2;
+        }
+    }
+
+public:
+    /**
+     * @brief Default constructor
+     *
+     * No memory is allocated until the first node is requested.
+     */
+    PoolAllocator() {
+        this->freeList = nullptr;
+        this->slabs = nullptr;
+        this->slabSize = minSlabSize;
+    }
+
+    /**
+     * @brief Destructor
+     *
+     * Returns every slab to the heap. All nodes must have been deallocated
+     * by the owning collection before this point.
+     */
+    ~PoolAllocator() {
+        while (this->slabs != nullptr) {
+            Slot* next = this->slabs[0].next;
+            delete[] this->slabs;
+            this->slabs = next;
+        }
+    }
+
+    // Nodes point into the slabs, so the pool cannot be copied
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+    /**
+     * @brief Get a default constructed node
+     * @return Pointer to the new node
+     */
+    N* allocate() {
+        if (this->freeList == nullptr) {
+            this->grow();
+        }
+
+        Slot* slot = this->freeList;
+        this->freeList = slot->next;
+        return new (slot->storage) N();
+    }
+
+    /**
+     * @brief Destroy a node and return its slot to the free list
+     * @param node The node to free (must come from this pool)
+     */
+    void deallocate(N* node) {
+        if (node == nullptr) {
+            return;
+        }
+
+        node->~N();
+        Slot* slot = reinterpret_cast<Slot*>(node);
+        slot->next = this->freeList;
+        this->freeList = slot;
+    }
+};
+
+/**
+ * @class HeapAllocator
+ * @brief Node allocator that uses plain new and delete for every node
+ *
+ * Collections can be instantiated with this allocator instead of the default
+ * PoolAllocator when nodes should go straight to the heap, for example when
+ * checking them with a memory debugger.
+ */
+template<class N> class HeapAllocator
+{
+public:
+    /**
+     * @brief Get a default constructed node
+     * @return Pointer to the new node
+     */
+    N* allocate() {
+        return new N();
+    }
+
+    /**
+     * @brief Delete a node
+     * @param node The node to free
+     */
+    void deallocate(N* node) {
+        delete node;
+    }
+};
+
+#endif // NODEPOOL_H
@@ -0,0 +1,217 @@
+#ifndef OWNERSHIPTABLE_H
+#define OWNERSHIPTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class OwnershipTable
+ * @brief Open-addressing hash table of owned data pointers used by Collections
+ *
+ * This class is used by the Collection base class to track which data elements
+ * it owns. Pointers are hashed by address into a power-of-two array of buckets and
+ * collisions are resolved with linear probing, so insert, lookup and removal are
+ * O(1) on average no matter how many elements are owned. Removal uses backward
+ * shift deletion, which keeps probe chains short without tombstones.
+ */
+template<class C> class OwnershipTable
+{
+private:
+    C** buckets;       // Slot array, nullptr marks an empty slot
+    size_t capacity;   // Number of buckets, always zero or a power of two
+    size_t count;      // Number of pointers stored in the table
+
+    static const size_t minCapacity = 16;
+
+    /**
+     * @brief Map a pointer to its home slot
+     * @param data The pointer to hash
+     * @return Index of the first slot to probe
+     */
+    size_t homeSlot(const C* data) const {
+        // Fibonacci hashing spreads the aligned (low-zero-bit) addresses
+        // across the whole table
+        uint64_t key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(data));
+        key ^= key >> 32;
+        key *= 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(key >> 32) & (this->capacity - 1);
+    }
+
+    /**
+     * @brief Find the slot holding a pointer
+     * @param data The pointer to look for
+     * @return Index of the slot, or capacity if the pointer is not stored
+     */
+    size_t findSlot(const C* data) const {
+        if (this->count == 0) {
+            return this->capacity;
+        }
+
+        size_t mask = this->capacity - 1;
+        for (size_t i = this->homeSlot(data); this->buckets[i] != nullptr; i = (i + 1) & mask) {
+            if (this->buckets[i] == data) {
+                return i;
+            }
+        }
+
+        return this->capacity;
+    }
+
+    /**
+     * @brief Reallocate the slot array and reinsert every pointer
+     * @param newCapacity The new number of buckets (a power of two)
+     */
+    void rehash(size_t newCapacity) {
+        C** oldSlots = this->buckets;
+        size_t oldCapacity = this->capacity;
+
+        this->buckets = new C*[newCapacity]();
+        this->capacity = newCapacity;
+
+        size_t mask = newCapacity - 1;
+        for (size_t i = 0; i < oldCapacity; i++) {
+            if (oldSlots[i] != nullptr) {
+                size_t j = this->homeSlot(oldSlots[i]);
+                while (this->buckets[j] != nullptr) {
+                    j = (j + 1) & mask;
+                }
+                this->buckets[j] = oldSlots[i];
+            }
+        }
+
+        delete[] oldSlots;
+    }
+
+public:
+    /**
+     * @brief Default constructor
+     *
+     * No memory is allocated until the first pointer is inserted.
+     */
+    OwnershipTable() {
+        this->buckets = nullptr;
+        this->capacity = 0;
+        this->count = 0;
+    }
+
+    /**
+     * @brief Destructor
+     *
+     * This destructor does not delete the stored pointers.
+     * Data deletion is handled by the Collection class.
+     */
+    ~OwnershipTable() {
+        delete[] this->buckets;
+    }
+
+    // The table owns its slot array, so it cannot be shallow copied
+    OwnershipTable(const OwnershipTable&) = delete;
+    OwnershipTable& operator=(const OwnershipTable&) = delete;
+
+    /**
+     * @brief Add a pointer to the table
+     * @param data The pointer to add (must not be nullptr)
+     * @return true if the pointer was added, false if it was already stored
+     */
+    bool insert(C* data) {
+        // Keep the load factor at or below 1/2 so probe chains stay short
+        if (this->capacity == 0) {
+            this->rehash(minCapacity);
+        } else if ((this->count + 1) * 2 > this->capacity) {
+            this->rehash(this->capacity * 2);
+        }
+
+        size_t mask = this->capacity - 1;
+        size_t i = this->homeSlot(data);
+        while (this->buckets[i] != nullptr) {
+            if (this->buckets[i] == data) {
+                return false;
+            }
+            i = (i + 1) & mask;
+        }
+
+        this->buckets[i] = data;
+        this->count++;
+        return true;
+    }
+
+    /**
+     * @brief Remove a pointer from the table
+     * @param data The pointer to remove
+     * @return true if the pointer was found and removed, false otherwise
+     */
+    bool remove(const C* data) {
+        size_t hole = this->findSlot(data);
+        if (hole == this->capacity) {
+            return false;
+        }
+
+        // Backward shift deletion: pull later members of the probe chain
+        // into the hole whenever the hole lies between their home slot and
+        // their current slot
+        size_t mask = this->capacity - 1;
+        size_t i = hole;
+        while (true) {
+            i = (i + 1) & mask;
+            if (this->buckets[i] == nullptr) {
+                break;
+            }
+
+            size_t home = this->homeSlot(this->buckets[i]);
+            if (((i - home) & mask) >= ((i - hole) & mask)) {
+                this->buckets[hole] = this->buckets[i];
+                hole = i;
+            }
+        }
+
+        this->buckets[hole] = nullptr;
+        this->count--;
+        return true;
+    }
+
+    /**
+     * @brief Check if a pointer is stored in the table
+     * @param data The pointer to check
+     * @return true if the pointer is stored, false otherwise
+     */
+    bool contains(const C* data) const {
+        return this->findSlot(data) != this->capacity;
+    }
+
+    /**
+     * @brief Get the number of stored pointers
+     * @return The number of pointers in the table
+     */
+    size_t getSize() const {
+        return this->count;
+    }
+
+    /**
+     * @brief Get the number of buckets
+     * @return The current slot array capacity
+     */
+    size_t getCapacity() const {
+        return this->capacity;
+    }
+
+    /**
+     * @brief Get the pointer stored in a slot
+     * @param index Slot index in [0, getCapacity())
+     * @return The stored pointer, or nullptr for an empty slot
+     */
+    C* slot(size_t index) const {
+        return this->buckets[index];
+    }
+
+    /**
+     * @brief Remove every pointer and free the slot array
+     */
+    void clear() {
+        delete[] this->buckets;
+        this->buckets = nullptr;
+        this->capacity = 0;
+        this->count = 0;
+    }
+};
+
+#endif // OWNERSHIPTABLE_H
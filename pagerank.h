@@ -0,0 +1,292 @@
+#ifndef PAGERANK_H
+#define PAGERANK_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "graph.h"
+#include "csrgraph.h"
+#include "sortedkernels.h"
+#include "threadpool.h"
+
+// Rows are handed out to the threads in blocks of this many. Sums over the
+// whole graph are added up per block and then in block order, so the
+// result does not depend on the number of threads.
+static const size_t pageRankBlock = 1024;
+
+/**
+ * @struct PageRankIteration
+ * @brief Timing report of one PageRank iteration
+ */
+struct PageRankIteration
+{
+    double seconds;   // Wall time of the iteration
+    double residual;  // L1 norm of the change in the ranks
+};
+
+/**
+ * @struct PageRank
+ * @brief Ranks of the vertices of a graph, indexed by vertex ID
+ *
+ * The ranks add up to 1. iterations holds one entry per iteration run,
+ * with its time and how much the ranks moved, so callers can report the
+ * cost of each sweep and how quickly it converged.
+ */
+struct PageRank
+{
+    std::vector<double> ranks;
+    std::vector<PageRankIteration> iterations;
+    bool converged;
+
+    PageRank() : converged(false) {
+    }
+
+    double getRank(uint32_t id) const {
+        return this->ranks[id];
+    }
+
+    int getIterationCount() const {
+        return static_cast<int>(this->iterations.size());
+    }
+
+    bool isConverged() const {
+        return this->converged;
+    }
+
+    // Total time of all iterations
+    double getSeconds() const {
+        double seconds = 0;
+        for (const PageRankIteration& iteration : this->iterations) {
+            seconds += iteration.seconds;
+        }
+        return seconds;
+    }
+};
+
+// Kernel internals; use pageRank below
+namespace pagerank_detail {
+
+// Sum of values[index[0 .. n)], with four accumulators so the additions
+// of neighbouring elements do not wait on each other
+inline double gatherSumScalar(const double* values, const uint32_t* index, size_t n) {
+    double sum0 = 0;
+    double sum1 = 0;
+    double sum2 = 0;
+    double sum3 = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        sum0 += values[index[i]];
+        sum1 += values[index[i + 1]];
+        sum2 += values[index[i + 2]];
+        sum3 += values[index[i + 3]];
+    }
+    for (; i < n; i++) {
+        sum0 += values[index[i]];
+    }
+
+    return (sum0 + sum1) + (sum2 + sum3);
+}
+
+#ifdef SORTEDKERNELS_X86
+
+// Eight values per step with two AVX2 gathers. SSE4.2 has no gather, so
+// that level uses the scalar version.
+__attribute__((target("avx2"))) inline double gatherSumAvx2(const double* values, const uint32_t* index, size_t n) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    __m256d sum0 = zero;
+    __m256d sum1 = zero;
+    size_t i = 0;
+
+    // The masked gather with every lane on is the plain gather, spelled
+    // so the compiler sees its source register initialised
+    for (; i + 8 <= n; i += 8) {
+        __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(index + i));
+        __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(index + i + 4));
+        sum0 = _mm256_add_pd(sum0, _mm256_mask_i32gather_pd(zero, values, low, all, 8));
+        sum1 = _mm256_add_pd(sum1, _mm256_mask_i32gather_pd(zero, values, high, all, 8));
+    }
+
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, _mm256_add_pd(sum0, sum1));
+    double sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+    for (; i < n; i++) {
+        sum += values[index[i]];
+    }
+    return sum;
+}
+
+#endif // SORTEDKERNELS_X86
+
+inline double gatherSum(const double* values, const uint32_t* index, size_t n, SimdLevel level) {
+#ifdef SORTEDKERNELS_X86
+    if (level >= SimdAvx2) {
+        return gatherSumAvx2(values, index, n);
+    }
+#endif
+    (void)level;
+    return gatherSumScalar(values, index, n);
+}
+
+} // namespace pagerank_detail
+
+// PageRank by power iteration on a thread pool. Every iteration is one
+// pull-based sparse matrix-vector product over the reversed edges of the
+// snapshot: each vertex gathers rank / out-degree from its in-neighbours,
+// so every rank is written by one thread and no atomics are needed.
+//
+//   rank'(v) = (1 - damping) / V + damping * (sum of the pulled shares + dangling / V)
+//
+// where dangling is the total rank of the vertices without out-edges,
+// which is spread over all vertices as if they linked to every one.
+// Iteration stops once the ranks move less than tolerance (in L1 norm) or
+// after maxIterations. The inner gather loop uses AVX2 where the CPU has
+// it; level can force a narrower one.
+//
+// Returns 0 when the ranks converged, 1 when maxIterations ran out first
+// (the ranks are still usable), and -1 for a damping outside [0, 1), a
+// negative tolerance or fewer than one iteration.
+template<typename T>
+int pageRank(const CsrGraph<T>* graph,
+             PageRank& result,
+             ThreadPool& pool,
+             double damping = 0.85,
+             double tolerance = 1e-6,
+             int maxIterations = 100,
+             SimdLevel level = detectSimdLevel()) {
+
+    if (!graph || !(damping >= 0 && damping < 1) || !(tolerance >= 0) || maxIterations < 1) {
+        return -1;
+    }
+
+    size_t vertexCount = static_cast<size_t>(graph->getVertexCount());
+    size_t blockCount = (vertexCount + pageRankBlock - 1) / pageRankBlock;
+    level = sortedkernels_detail::usableLevel(level);
+
+    result.ranks.assign(vertexCount, vertexCount > 0 ? 1.0 / vertexCount : 0.0);
+    result.iterations.clear();
+    result.converged = vertexCount == 0;
+    if (vertexCount == 0) {
+        return 0;
+    }
+
+    std::vector<double> next(vertexCount);
+    std::vector<double> share(vertexCount);       // rank / out-degree of each vertex
+    std::vector<double> danglingSums(blockCount);  // Rank of the dangling vertices, per block
+    std::vector<double> residuals(blockCount);     // Change of the ranks, per block
+    std::atomic<size_t> shareCursor(0);
+    std::atomic<size_t> pullCursor(0);
+
+    // Run visit(block, begin, end) for every block of rows, claimed by the
+    // threads from cursor
+    auto forEachBlock = [&](std::atomic<size_t>& cursor, auto visit) {
+        forEachClaimed(cursor, blockCount, 1, [&](size_t block) {
+            visit(block, block * pageRankBlock, std::min((block + 1) * pageRankBlock, vertexCount));
+        });
+    };
+
+    pool.run([&](unsigned thread) {
+        double* rank = result.ranks.data();
+        double* following = next.data();
+
+        for (int iteration = 0; iteration < maxIterations; iteration++) {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            forEachBlock(shareCursor, [&](size_t block, size_t begin, size_t end) {
+                double dangling = 0;
+                for (size_t id = begin; id < end; id++) {
+                    uint32_t degree = graph->degree(static_cast<uint32_t>(id));
+                    if (degree == 0) {
+                        dangling += rank[id];
+                        share[id] = 0;
+                    } else {
+                        share[id] = rank[id] / degree;
+                    }
+                }
+                danglingSums[block] = dangling;
+            });
+            pool.barrier();
+
+            // Every thread adds up the same blocks in the same order
+            double dangling = 0;
+            for (double sum : danglingSums) {
+                dangling += sum;
+            }
+            double base = (1 - damping + damping * dangling) / vertexCount;
+
+            // Each cursor is reset after a barrier that every thread passes
+            // before it is used again
+            if (thread == 0) {
+                shareCursor.store(0, std::memory_order_relaxed);
+            }
+
+            forEachBlock(pullCursor, [&](size_t block, size_t begin, size_t end) {
+                double residual = 0;
+                for (size_t id = begin; id < end; id++) {
+                    const uint32_t* in = graph->incomingBegin(static_cast<uint32_t>(id));
+                    size_t count = graph->inDegree(static_cast<uint32_t>(id));
+
+                    following[id] = base + damping * pagerank_detail::gatherSum(share.data(), in, count, level);
+                    residual += std::fabs(following[id] - rank[id]);
+                }
+                residuals[block] = residual;
+            });
+            pool.barrier();
+
+            double residual = 0;
+            for (double sum : residuals) {
+                residual += sum;
+            }
+            std::swap(rank, following);
+
+            if (thread == 0) {
+                pullCursor.store(0, std::memory_order_relaxed);
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                result.iterations.push_back(PageRankIteration{elapsed.count(), residual});
+            }
+
+            if (residual < tolerance) {
+                if (thread == 0) {
+                    result.converged = true;
+                }
+                break;
+            }
+        }
+
+        // The latest ranks may be in the scratch vector
+        if (thread == 0 && rank != result.ranks.data()) {
+            result.ranks.swap(next);
+        }
+    });
+
+    return result.converged ? 0 : 1;
+}
+
+// PageRank of a Graph. The list-based graph is snapshot to a CsrGraph
+// first, so vertex ID i is the i-th vertex of the graph's adjacency lists,
+// as in CsrGraph.
+template<typename T, typename Compare, typename Hash, typename AdjacentSet>
+int pageRank(Graph<T, Compare, Hash, AdjacentSet>* graph,
+             PageRank& result,
+             ThreadPool& pool,
+             double damping = 0.85,
+             double tolerance = 1e-6,
+             int maxIterations = 100,
+             SimdLevel level = detectSimdLevel()) {
+
+    if (!graph) {
+        return -1;
+    }
+
+    CsrGraph<T> snapshot(*graph);
+    return pageRank(&snapshot, result, pool, damping, tolerance, maxIterations, level);
+}
+
+#endif // PAGERANK_H
@@ -0,0 +1,101 @@
+#ifndef PARALLELBFS_H
+#define PARALLELBFS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "list.h"
+#include "graph.h"
+#include "csrgraph.h"
+#include "bfsvertex.h"
+#include "threadpool.h"
+
+// Level-synchronous breadth-first search on a thread pool. Gives the same
+// colors, hops and hop list as bfs.
+//
+// The levels are expanded by expandFrontier. A neighbour is claimed for
+// the next level with a compare-and-swap on its distance, so exactly one
+// thread discovers each vertex.
+template<typename T>
+int parallelBfs(const CsrGraph<T>* graph,
+                T* start,
+                List<T>& hops,
+                ThreadPool& pool) {
+
+    if (!graph || !start) {
+        return -1; // Invalid parameters
+    }
+
+    uint32_t source = graph->idOf(start);
+    if (source == CsrGraph<T>::noVertex) {
+        return -1;  // Starting vertex not found
+    }
+
+    uint32_t vertexCount = static_cast<uint32_t>(graph->getVertexCount());
+    std::unique_ptr<std::atomic<int>[]> distance(new std::atomic<int>[vertexCount]);
+    for (uint32_t id = 0; id < vertexCount; id++) {
+        distance[id].store(-1, std::memory_order_relaxed);
+    }
+
+    std::vector<uint32_t> frontier(1, source);
+    distance[source].store(0, std::memory_order_relaxed);
+
+    // Every vertex is in at most one frontier
+    expandFrontier(pool, frontier, vertexCount, [&](uint32_t vertex, uint32_t level, std::vector<uint32_t>& discovered) {
+        for (const uint32_t* adj = graph->adjacentBegin(vertex); adj != graph->adjacentEnd(vertex); adj++) {
+            // Cheap read first, most neighbours are already claimed
+            if (distance[*adj].load(std::memory_order_relaxed) != -1) {
+                continue;
+            }
+
+            int unvisited = -1;
+            if (distance[*adj].compare_exchange_strong(unvisited, static_cast<int>(level) + 1, std::memory_order_relaxed)) {
+                discovered.push_back(*adj);
+            }
+        }
+    });
+
+    hops.clear();
+
+    for (uint32_t id = 0; id < vertexCount; id++) {
+        T* vertex = graph->vertex(id);
+        int hopCount = distance[id].load(std::memory_order_relaxed);
+        vertex->setHops(hopCount);
+
+        if (hopCount != -1) {
+            vertex->setColor(black);
+            hops.insertUnchecked(hops.tail(), vertex);
+        } else {
+            vertex->setColor(white);
+        }
+    }
+
+    return 0;
+}
+
+// Parallel breadth-first search on a Graph. The list-based graph is
+// snapshot to a CsrGraph first, so this pays O(V + E) for the snapshot;
+// keep a CsrGraph around when searching the same graph many times.
+template<typename T, typename Compare, typename Hash, typename AdjacentSet>
+int parallelBfs(Graph<T, Compare, Hash, AdjacentSet>* graph,
+                T* start,
+                List<T>& hops,
+                ThreadPool& pool) {
+
+    if (!graph || !start) {
+        return -1; // Invalid parameters
+    }
+
+    ListNode<AdjacentList<T, Compare, Hash, AdjacentSet>>* node = graph->findNodeByVertex(start);
+    if (node == nullptr) {
+        return -1;  // Starting vertex not found
+    }
+
+    CsrGraph<T> snapshot(*graph);
+    return parallelBfs(&snapshot, node->data()->vertex, hops, pool);
+}
+
+#endif // PARALLELBFS_H
@@ -1,43 +1,114 @@
 #ifndef QUEUE_H
 #define QUEUE_H
 
-#include "list.h"
+#include <cstddef>
+#include <functional>
 
-template <class C> class Queue : public List<C>
+#include "collection.h"
+
+// FIFO queue stored in a contiguous, growable circular buffer of element
+// pointers. Elements live in buffer[(front + i) & (capacity - 1)] for
+// i in [0, size), so enqueue, dequeue and peek are O(1) with no per-element
+// allocation and no pointer chasing.
+template <class C> class Queue : public Collection<C>
 {
+private:
+    C** buffer;        // Circular buffer of queued elements
+    size_t capacity;   // Buffer length, always zero or a power of two
+    size_t front;      // Index of the element at the front of the queue
+
+    static const size_t minCapacity = 16;
+
+    // Move the queued elements into a new buffer of the given capacity
+    void grow(size_t newCapacity) {
+        C** newBuffer = new C*[newCapacity];
+
+        // Unwrap the elements so the front lands at index 0
+        for (size_t i = 0; i < static_cast<size_t>(this->size); i++) {
+            newBuffer[i] = this->buffer[(this->front + i) & (this->capacity - 1)];
+        }
+
+        delete[] this->buffer;
+        this->buffer = newBuffer;
+        this->capacity = newCapacity;
+        this->front = 0;
+    }
+
 public:
     Queue() {
-        // Already initialized properly by List constructor
+        this->buffer = nullptr;
+        this->capacity = 0;
+        this->front = 0;
+    }
+
+    ~Queue() override {
+        // Owned elements are deleted by the Collection destructor
+        delete[] this->buffer;
     }
-    
+
+    // The queue owns its buffer, so it cannot be shallow copied
+    Queue(const Queue&) = delete;
+    Queue& operator=(const Queue&) = delete;
+
     // Enqueue: adds element to the back of the queue
-    void enqueue(C* data) {
-        // Since we're now checking for null data in List::insert,
-        // no additional null check is needed here
-        this->List<C>::insert(this->List<C>::tail(), data);
+    void enqueue(C* data, bool takeOwnership = false) {
+        // Don't enqueue null data
+        if (data == nullptr) {
+            return;
+        }
+
+        if (static_cast<size_t>(this->size) == this->capacity) {
+            this->grow(this->capacity == 0 ? minCapacity : this->capacity * 2);
+        }
+
+        this->buffer[(this->front + this->size) & (this->capacity - 1)] = data;
+
+        // Take ownership of the data if requested
+        if (takeOwnership) {
+            this->takeOwnership(data);
+        }
+
+        this->size++;
     }
-    
+
     // Dequeue: removes element from the front of the queue
     void dequeue(C** data) {
-        // List::remove has been improved with robust error handling
-        this->remove(nullptr, data);
+        if (this->size == 0) {
+            if (data != nullptr) {
+                *data = nullptr;
+            }
+            return;
+        }
+
+        C* removedData = this->buffer[this->front];
+        this->front = (this->front + 1) & (this->capacity - 1);
+        this->size--;
+
+        if (data != nullptr) {
+            *data = removedData;
+        }
+
+        // Release ownership of the data if we owned it
+        if (this->hasOwnership(removedData)) {
+            this->releaseOwnership(removedData);
+        }
     }
-    
+
     // Peek: look at front element without removing
-    C* peek() {
-        if (this->List<C>::head() == nullptr) {
+    C* peek() const {
+        if (this->size == 0) {
             return nullptr;
         }
-        return this->List<C>::head()->data();
+        return this->buffer[this->front];
     }
-    
+
     // Additional useful methods
-    
+
     // Check if queue is empty
     bool isEmpty() const {
         return this->getSize() == 0;
     }
-    
+
     // Clear the entire queue
     void clear() {
         C* data;
@@ -45,6 +116,26 @@ public:
             this->dequeue(&data);
         }
     }
+
+    // Make room for at least n elements so that enqueueing up to n
+    // elements never reallocates (e.g. BFS sizing by vertex count)
+    void reserve(size_t n) {
+        if (n <= this->capacity) {
+            return;
+        }
+
+        size_t newCapacity = this->capacity == 0 ? minCapacity : this->capacity;
+        while (newCapacity < n) {
+            newCapacity *= 2;
+        }
+
+        this->grow(newCapacity);
+    }
+
+    // Number of elements the queue can hold before it has to grow
+    size_t getCapacity() const {
+        return this->capacity;
+    }
 };
 
 #endif // QUEUE_H
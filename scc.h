@@ -0,0 +1,426 @@
+#ifndef SCC_H
+#define SCC_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "graph.h"
+#include "csrgraph.h"
+#include "threadpool.h"
+
+/**
+ * @struct Condensation
+ * @brief Strongly connected components of a graph and the DAG between them
+ *
+ * component holds the component ID of every vertex ID. Component IDs are a
+ * topological order of the condensation: every edge between two components
+ * goes from the lower ID to the higher one, so scheduling the components in
+ * ID order respects every edge of the graph.
+ *
+ * The condensation is stored like a CsrGraph: the components reached by
+ * edges out of component c are edgesBegin(c) .. edgesEnd(c), each once and
+ * in increasing order, and the vertices of c are membersBegin(c) ..
+ * membersEnd(c), in increasing ID order.
+ */
+struct Condensation
+{
+    std::vector<uint32_t> component;      // Component ID of each vertex ID
+    std::vector<uint32_t> offsets;        // Row starts into edges, one per component plus one
+    std::vector<uint32_t> edges;          // Component IDs, grouped by source component
+    std::vector<uint32_t> memberOffsets;  // Row starts into members
+    std::vector<uint32_t> members;        // Vertex IDs, grouped by component
+
+    uint32_t getComponentCount() const {
+        return this->offsets.empty() ? 0 : static_cast<uint32_t>(this->offsets.size() - 1);
+    }
+
+    uint32_t getComponent(uint32_t id) const {
+        return this->component[id];
+    }
+
+    const uint32_t* edgesBegin(uint32_t c) const {
+        return this->edges.data() + this->offsets[c];
+    }
+
+    const uint32_t* edgesEnd(uint32_t c) const {
+        return this->edges.data() + this->offsets[c + 1];
+    }
+
+    const uint32_t* membersBegin(uint32_t c) const {
+        return this->members.data() + this->memberOffsets[c];
+    }
+
+    const uint32_t* membersEnd(uint32_t c) const {
+        return this->members.data() + this->memberOffsets[c + 1];
+    }
+};
+
+// Fill in the members and edges of a condensation whose component array
+// already holds IDs in [0, componentCount). O(V + E).
+template<typename T>
+void buildCondensation(const CsrGraph<T>* graph, Condensation& condensation, uint32_t componentCount) {
+    uint32_t vertexCount = static_cast<uint32_t>(graph->getVertexCount());
+    const std::vector<uint32_t>& component = condensation.component;
+
+    // Counting sort of the vertices by component
+    condensation.memberOffsets.assign(componentCount + 1, 0);
+    for (uint32_t id = 0; id < vertexCount; id++) {
+        condensation.memberOffsets[component[id] + 1]++;
+    }
+    for (uint32_t c = 0; c < componentCount; c++) {
+        condensation.memberOffsets[c + 1] += condensation.memberOffsets[c];
+    }
+
+    condensation.members.resize(vertexCount);
+    std::vector<uint32_t> fill(condensation.memberOffsets.begin(), condensation.memberOffsets.end() - 1);
+    for (uint32_t id = 0; id < vertexCount; id++) {
+        condensation.members[fill[component[id]]++] = id;
+    }
+
+    // lastSeen[d] == c when the edge c -> d is already in row c
+    std::vector<uint32_t> lastSeen(componentCount, CsrGraph<T>::noVertex);
+    condensation.offsets.assign(1, 0);
+    condensation.edges.clear();
+
+    for (uint32_t c = 0; c < componentCount; c++) {
+        for (const uint32_t* member = condensation.membersBegin(c); member != condensation.membersEnd(c); member++) {
+            for (const uint32_t* adj = graph->adjacentBegin(*member); adj != graph->adjacentEnd(*member); adj++) {
+                uint32_t d = component[*adj];
+
+                if (d != c && lastSeen[d] != c) {
+                    lastSeen[d] = c;
+                    condensation.edges.push_back(d);
+                }
+            }
+        }
+
+        std::sort(condensation.edges.begin() + condensation.offsets.back(), condensation.edges.end());
+        condensation.offsets.push_back(static_cast<uint32_t>(condensation.edges.size()));
+    }
+}
+
+// Strongly connected components with Tarjan's algorithm, O(V + E). An
+// explicit stack of (vertex, next edge) frames replaces the recursion, so
+// long paths cannot overflow the call stack.
+//
+// Tarjan finishes the components in reverse topological order, so the
+// k-th component finished out of n gets the ID n - 1 - k.
+template<typename T>
+int scc(const CsrGraph<T>* graph, Condensation& condensation) {
+    if (!graph) {
+        return -1;
+    }
+
+    const uint32_t none = CsrGraph<T>::noVertex;
+    uint32_t vertexCount = static_cast<uint32_t>(graph->getVertexCount());
+
+    // A vertex is on the Tarjan stack while it has an index but no component
+    std::vector<uint32_t> index(vertexCount, none);
+    std::vector<uint32_t> low(vertexCount);
+    std::vector<uint32_t>& component = condensation.component;
+    component.assign(vertexCount, none);
+
+    std::vector<uint32_t> open;  // Vertices whose component is not known yet
+    std::vector<std::pair<uint32_t, const uint32_t*>> frames;
+    uint32_t nextIndex = 0;
+    uint32_t finishedCount = 0;
+
+    for (uint32_t root = 0; root < vertexCount; root++) {
+        if (index[root] != none) {
+            continue;
+        }
+
+        index[root] = low[root] = nextIndex++;
+        open.push_back(root);
+        frames.push_back(std::make_pair(root, graph->adjacentBegin(root)));
+
+        while (!frames.empty()) {
+            uint32_t current = frames.back().first;
+            const uint32_t*& edge = frames.back().second;
+
+            if (edge != graph->adjacentEnd(current)) {
+                uint32_t next = *edge++;
+
+                if (index[next] == none) {
+                    index[next] = low[next] = nextIndex++;
+                    open.push_back(next);
+                    frames.push_back(std::make_pair(next, graph->adjacentBegin(next)));
+                } else if (component[next] == none) {
+                    low[current] = std::min(low[current], index[next]);
+                }
+                continue;
+            }
+
+            frames.pop_back();
+
+            // current roots a component: everything above it on the stack
+            if (low[current] == index[current]) {
+                uint32_t member;
+                do {
+                    member = open.back();
+                    open.pop_back();
+                    component[member] = finishedCount;
+                } while (member != current);
+                finishedCount++;
+            }
+
+            if (!frames.empty()) {
+                uint32_t parent = frames.back().first;
+                low[parent] = std::min(low[parent], low[current]);
+            }
+        }
+    }
+
+    for (uint32_t id = 0; id < vertexCount; id++) {
+        component[id] = finishedCount - 1 - component[id];
+    }
+
+    buildCondensation(graph, condensation, finishedCount);
+    return 0;
+}
+
+// Level-synchronous parallel expansion used by the phases of parallelScc.
+// Starting from frontier, follows the edges forward, or backward when
+// forward is false, and calls visit(from, to, level) for each edge out of
+// the current level. visit returns true to put to in the next level, and
+// must do so at most once per vertex and level.
+template<typename T, typename Visit>
+void sccExpand(const CsrGraph<T>* graph, ThreadPool& pool, std::vector<uint32_t>& frontier, bool forward, Visit visit) {
+    expandFrontier(pool, frontier, static_cast<size_t>(graph->getVertexCount()), [&](uint32_t vertex, uint32_t level, std::vector<uint32_t>& discovered) {
+        const uint32_t* adj = forward ? graph->adjacentBegin(vertex) : graph->incomingBegin(vertex);
+        const uint32_t* last = forward ? graph->adjacentEnd(vertex) : graph->incomingEnd(vertex);
+
+        for (; adj != last; adj++) {
+            if (visit(vertex, *adj, level)) {
+                discovered.push_back(*adj);
+            }
+        }
+    });
+}
+
+// Strongly connected components on a thread pool, following the
+// forward-backward-trim scheme of Hong et al.:
+//
+//  1. Trim: vertices with no in-edges, then vertices with no out-edges,
+//     among the vertices left, are components of their own. Removing them
+//     can expose more, so they are peeled level by level like Kahn's
+//     algorithm, which also clears long chains in one pass.
+//  2. Forward-backward: the vertices both reachable from and reaching a
+//     pivot of high degree form its component, which on most large graphs
+//     is the giant one.
+//  3. Coloring: every remaining vertex takes the largest ID that reaches
+//     it. A vertex keeping its own ID roots a component made of the
+//     vertices of its color that reach it backwards. Repeat until every
+//     vertex has a component.
+//
+// The result is the same partition as scc, and the component IDs are
+// renumbered into a topological order of the condensation, so the IDs
+// themselves can differ from those of scc.
+template<typename T>
+int parallelScc(const CsrGraph<T>* graph, Condensation& condensation, ThreadPool& pool) {
+    if (!graph) {
+        return -1;
+    }
+
+    const uint32_t none = CsrGraph<T>::noVertex;
+    uint32_t vertexCount = static_cast<uint32_t>(graph->getVertexCount());
+
+    std::unique_ptr<std::atomic<uint32_t>[]> component(new std::atomic<uint32_t>[vertexCount]);
+    std::unique_ptr<std::atomic<uint32_t>[]> scratch(new std::atomic<uint32_t>[vertexCount]);
+    std::atomic<uint32_t> nextComponent(0);
+    std::vector<uint32_t> frontier;
+
+    parallelFor(pool, vertexCount, parallelChunk, [&](unsigned, size_t id) {
+        component[id].store(none, std::memory_order_relaxed);
+    });
+
+    auto isOpen = [&](uint32_t id) {
+        return component[id].load(std::memory_order_relaxed) == none;
+    };
+
+    // 1. Trim by in-degree, then by out-degree. scratch counts the edges
+    // from (to) other open vertices; self loops never keep a vertex.
+    for (bool forward : {true, false}) {
+        parallelFor(pool, vertexCount, parallelChunk, [&](unsigned, size_t id) {
+            uint32_t vertex = static_cast<uint32_t>(id);
+            uint32_t count = 0;
+
+            if (isOpen(vertex)) {
+                const uint32_t* adj = forward ? graph->incomingBegin(vertex) : graph->adjacentBegin(vertex);
+                const uint32_t* last = forward ? graph->incomingEnd(vertex) : graph->adjacentEnd(vertex);
+                for (; adj != last; adj++) {
+                    count += *adj != vertex && isOpen(*adj);
+                }
+            }
+            scratch[id].store(count, std::memory_order_relaxed);
+        });
+
+        for (uint32_t id = 0; id < vertexCount; id++) {
+            if (isOpen(id) && scratch[id].load(std::memory_order_relaxed) == 0) {
+                component[id].store(nextComponent++, std::memory_order_relaxed);
+                frontier.push_back(id);
+            }
+        }
+
+        sccExpand(graph, pool, frontier, forward, [&](uint32_t from, uint32_t to, uint32_t) {
+            if (to == from || !isOpen(to) || scratch[to].fetch_sub(1, std::memory_order_relaxed) != 1) {
+                return false;
+            }
+            component[to].store(nextComponent.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+            return true;
+        });
+    }
+
+    // 2. Forward-backward from the open vertex with the most in * out edges
+    uint32_t pivot = none;
+    uint64_t pivotWeight = 0;
+    for (uint32_t id = 0; id < vertexCount; id++) {
+        uint64_t weight = uint64_t(graph->inDegree(id)) * graph->degree(id);
+        if (isOpen(id) && (pivot == none || weight > pivotWeight)) {
+            pivot = id;
+            pivotWeight = weight;
+        }
+    }
+
+    if (pivot != none) {
+        const uint32_t forwardMark = 1;
+
+        parallelFor(pool, vertexCount, parallelChunk, [&](unsigned, size_t id) {
+            scratch[id].store(0, std::memory_order_relaxed);
+        });
+
+        scratch[pivot].store(forwardMark, std::memory_order_relaxed);
+        frontier.push_back(pivot);
+        sccExpand(graph, pool, frontier, true, [&](uint32_t, uint32_t to, uint32_t) {
+            uint32_t unmarked = 0;
+            return isOpen(to) && scratch[to].compare_exchange_strong(unmarked, forwardMark, std::memory_order_relaxed);
+        });
+
+        uint32_t giant = nextComponent++;
+        component[pivot].store(giant, std::memory_order_relaxed);
+        frontier.push_back(pivot);
+        sccExpand(graph, pool, frontier, false, [&](uint32_t, uint32_t to, uint32_t) {
+            uint32_t open = none;
+            return scratch[to].load(std::memory_order_relaxed) == forwardMark &&
+                   component[to].compare_exchange_strong(open, giant, std::memory_order_relaxed);
+        });
+    }
+
+    // 3. Coloring rounds until no vertex is open. scratch holds the colors,
+    // and queued the last level each vertex was put in the next frontier.
+    std::unique_ptr<std::atomic<uint32_t>[]> queued(new std::atomic<uint32_t>[vertexCount]);
+
+    while (true) {
+        for (uint32_t id = 0; id < vertexCount; id++) {
+            if (isOpen(id)) {
+                scratch[id].store(id, std::memory_order_relaxed);
+                queued[id].store(none, std::memory_order_relaxed);
+                frontier.push_back(id);
+            }
+        }
+
+        if (frontier.empty()) {
+            break;
+        }
+
+        // Spread the largest color forward until nothing changes
+        sccExpand(graph, pool, frontier, true, [&](uint32_t from, uint32_t to, uint32_t level) {
+            if (!isOpen(to)) {
+                return false;
+            }
+
+            uint32_t color = scratch[from].load(std::memory_order_relaxed);
+            uint32_t seen = scratch[to].load(std::memory_order_relaxed);
+            while (seen < color && !scratch[to].compare_exchange_weak(seen, color, std::memory_order_relaxed)) {
+            }
+
+            return seen < color && queued[to].exchange(level, std::memory_order_relaxed) != level;
+        });
+
+        // Each root claims the vertices of its color that reach it
+        for (uint32_t id = 0; id < vertexCount; id++) {
+            if (isOpen(id) && scratch[id].load(std::memory_order_relaxed) == id) {
+                frontier.push_back(id);
+            }
+        }
+        for (uint32_t root : frontier) {
+            component[root].store(nextComponent++, std::memory_order_relaxed);
+        }
+
+        sccExpand(graph, pool, frontier, false, [&](uint32_t from, uint32_t to, uint32_t) {
+            uint32_t open = none;
+            return scratch[to].load(std::memory_order_relaxed) == scratch[from].load(std::memory_order_relaxed) &&
+                   component[to].compare_exchange_strong(open, component[from].load(std::memory_order_relaxed),
+                                                         std::memory_order_relaxed);
+        });
+    }
+
+    uint32_t componentCount = nextComponent.load();
+    condensation.component.resize(vertexCount);
+    for (uint32_t id = 0; id < vertexCount; id++) {
+        condensation.component[id] = component[id].load(std::memory_order_relaxed);
+    }
+    buildCondensation(graph, condensation, componentCount);
+
+    // Renumber the components in a topological order found with Kahn's
+    // algorithm on the condensation, then rebuild it with the new IDs
+    std::vector<uint32_t> inCount(componentCount, 0);
+    for (uint32_t d : condensation.edges) {
+        inCount[d]++;
+    }
+
+    std::vector<uint32_t> order;
+    order.reserve(componentCount);
+    for (uint32_t c = 0; c < componentCount; c++) {
+        if (inCount[c] == 0) {
+            order.push_back(c);
+        }
+    }
+    for (size_t i = 0; i < order.size(); i++) {
+        for (const uint32_t* d = condensation.edgesBegin(order[i]); d != condensation.edgesEnd(order[i]); d++) {
+            if (--inCount[*d] == 0) {
+                order.push_back(*d);
+            }
+        }
+    }
+
+    std::vector<uint32_t> renamed(componentCount);
+    for (uint32_t position = 0; position < componentCount; position++) {
+        renamed[order[position]] = position;
+    }
+    for (uint32_t id = 0; id < vertexCount; id++) {
+        condensation.component[id] = renamed[condensation.component[id]];
+    }
+    buildCondensation(graph, condensation, componentCount);
+
+    return 0;
+}
+
+// Strongly connected components of a Graph. The list-based graph is
+// snapshot to a CsrGraph first, so vertex ID i is the i-th vertex of the
+// graph's adjacency lists, as in CsrGraph.
+template<typename T, typename Compare, typename Hash, typename AdjacentSet>
+int scc(Graph<T, Compare, Hash, AdjacentSet>* graph, Condensation& condensation) {
+    if (!graph) {
+        return -1;
+    }
+
+    CsrGraph<T> snapshot(*graph);
+    return scc(&snapshot, condensation);
+}
+
+template<typename T, typename Compare, typename Hash, typename AdjacentSet>
+int parallelScc(Graph<T, Compare, Hash, AdjacentSet>* graph, Condensation& condensation, ThreadPool& pool) {
+    if (!graph) {
+        return -1;
+    }
+
+    CsrGraph<T> snapshot(*graph);
+    return parallelScc(&snapshot, condensation, pool);
+}
+
+#endif // SCC_H
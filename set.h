@@ -7,13 +7,67 @@
 
 #include "setnode.h"
 #include "collection.h"
-
-template <class C, class Compare = std::equal_to<C>>
+#include "nodepool.h"
+#include "hashindex.h"
+
+// Set of element pointers kept in insertion order in a doubly linked list
+// of SetNodes, so callers can iterate with head()/next().
+//
+// Membership is decided with Compare. When a Hash consistent with Compare
+// is supplied the set also keeps a hash index over its nodes, which makes
+// isMember, insert and remove O(1) on average and the set operations
+// linear. With the default NoHash membership is a linear scan.
+template <class C, class Compare = std::equal_to<C>, class Hash = NoHash<C>,
+          template <class> class Allocator = PoolAllocator>
 class Set : public Collection<C, Compare>
 {
 private:
+    // Key extractor for the member index
+    struct MemberKey
+    {
+        C *operator()(const SetNode<C> *node) const
+        {
+            return node->data();
+        }
+    };
+
     SetNode<C> *h; // Head pointer
     SetNode<C> *t; // Tail pointer
+    Allocator<SetNode<C>> nodes; // Node allocator, reuses freed nodes
+    HashIndex<SetNode<C>, C, Hash, Compare, MemberKey> members; // Index of members by value (hashed sets only)
+
+    // Find the node holding an element equal to data
+    SetNode<C> *findNode(const C *data) const
+    {
+        if constexpr (IsHashed<C, Hash>::value)
+        {
+            // Null elements are not indexed and only match by pointer below
+            if (data != nullptr)
+            {
+                return this->members.find(data);
+            }
+        }
+
+        SetNode<C> *current;
+
+        for (current = this->head(); current != nullptr; current = current->next())
+        {
+            if (data != nullptr && current->data() != nullptr) {
+                if (this->equalTo(*data, *(current->data()))) {
+                    return current;
+                }
+            }
+            else
+            {
+                if (data == current->data())
+                {
+                    return current;
+                }
+            }
+        }
+
+        return nullptr;
+    }
 
 public:
     // Constructors and destructor
@@ -23,7 +77,13 @@ public:
         this->t = nullptr;
     }
 
-    Set(const Compare &comp) : Collection<C, Compare>(comp)
+    Set(const Compare &comp) : Collection<C, Compare>(comp), members(comp)
+    {
+        this->h = nullptr;
+        this->t = nullptr;
+    }
+
+    Set(const Compare &comp, const Hash &hash) : Collection<C, Compare>(comp), members(comp, hash)
     {
         this->h = nullptr;
         this->t = nullptr;
@@ -39,7 +99,7 @@ public:
         while (current != nullptr)
         {
             next = current->next();
-            delete current;
+            this->nodes.deallocate(current);
             current = next;
         }
 
@@ -80,25 +140,7 @@ public:
     // Check if an element is in the set
     bool isMember(const C *data) const
     {
-        SetNode<C> *current;
-
-        for (current = this->head(); current != nullptr; current = current->next())
-        {
-            if (data != nullptr && current->data() != nullptr) {
-                if (this->equalTo(*data, *(current->data()))) {
-                    return true;
-                }
-            }
-            else
-            {
-                if (data == current->data())
-                {
-                    return true;
-                }
-            }
-        }
-
-        return false;
+        return this->findNode(data) != nullptr;
     }
 
     // Insert an element into the set if it doesn't already exist
@@ -107,9 +149,10 @@ public:
         // Only insert if the element isn't already in the set
         if (!this->isMember(data))
         {
-            SetNode<C> *newNode = new SetNode<C>();
+            SetNode<C> *newNode = this->nodes.allocate();
             newNode->setData(data);
             newNode->setNext(nullptr);
+            newNode->setPrev(this->t);
 
             if (this->size == 0)
             {
@@ -124,6 +167,11 @@ public:
                 this->t = newNode;
             }
 
+            if constexpr (IsHashed<C, Hash>::value)
+            {
+                this->members.insert(newNode);
+            }
+
             // Take ownership if requested
             if (takeOwnership && data != nullptr)
             {
@@ -137,17 +185,7 @@ public:
     // Remove an element from the set
     bool remove(C *data)
     {
-        SetNode<C> *current;
-        SetNode<C> *previous = nullptr;
-
-        // Find the node containing data
-        for (current = this->h; current != nullptr; current = current->next())
-        {
-            if (this->equalTo(*data, *(current->data()))) {
-                break;
-            }
-            previous = current;
-        }
+        SetNode<C> *current = this->findNode(data);
 
         // Return false if not found
         if (current == nullptr)
@@ -155,8 +193,13 @@ public:
             return false;
         }
 
-        // Remove the node
-        if (previous == nullptr)
+        if constexpr (IsHashed<C, Hash>::value)
+        {
+            this->members.remove(current);
+        }
+
+        // Unlink the node using its neighbours
+        if (current->prev() == nullptr)
         {
             // Removing the head node
             this->h = current->next();
@@ -164,13 +207,17 @@ public:
         else
         {
             // Removing an internal or tail node
-            previous->setNext(current->next());
+            current->prev()->setNext(current->next());
         }
 
-        // Update tail if removing the last node
         if (current->next() == nullptr)
         {
-            this->t = previous;
+            // Update tail if removing the last node
+            this->t = current->prev();
+        }
+        else
+        {
+            current->next()->setPrev(current->prev());
         }
 
         // Release ownership if we owned the data
@@ -180,14 +227,14 @@ public:
         }
 
         // Clean up and update size
-        delete current;
+        this->nodes.deallocate(current);
         this->size--;
 
         return true;
     }
 
     // Set operations
-    static void unionSet(Set<C, Compare> *result, const Set<C, Compare> *set1, const Set<C, Compare> *set2)
+    static void unionSet(Set<C, Compare, Hash, Allocator> *result, const Set<C, Compare, Hash, Allocator> *set1, const Set<C, Compare, Hash, Allocator> *set2)
     {
         SetNode<C> *current;
 
@@ -207,7 +254,7 @@ public:
         }
     }
 
-    static void intersectionSet(Set<C, Compare> *result, const Set<C, Compare> *set1, const Set<C, Compare> *set2)
+    static void intersectionSet(Set<C, Compare, Hash, Allocator> *result, const Set<C, Compare, Hash, Allocator> *set1, const Set<C, Compare, Hash, Allocator> *set2)
     {
         SetNode<C> *current;
 
@@ -221,7 +268,7 @@ public:
         }
     }
 
-    static void differenceSet(Set<C, Compare> *result, const Set<C, Compare> *set1, const Set<C, Compare> *set2)
+    static void differenceSet(Set<C, Compare, Hash, Allocator> *result, const Set<C, Compare, Hash, Allocator> *set1, const Set<C, Compare, Hash, Allocator> *set2)
     {
         SetNode<C> *current;
 
@@ -235,7 +282,7 @@ public:
         }
     }
 
-    static bool isSubset(const Set<C, Compare> *set1, const Set<C, Compare> *set2)
+    static bool isSubset(const Set<C, Compare, Hash, Allocator> *set1, const Set<C, Compare, Hash, Allocator> *set2)
     {
         SetNode<C> *current;
 
@@ -257,7 +304,7 @@ public:
         return true;
     }
 
-    static bool isEqualSet(const Set<C, Compare> *set1, const Set<C, Compare> *set2)
+    static bool isEqualSet(const Set<C, Compare, Hash, Allocator> *set1, const Set<C, Compare, Hash, Allocator> *set2)
     {
         // Sets are equal if they have the same size and set1 is a subset of set2
         return (set1->size == set2->size) && isSubset(set1, set2);
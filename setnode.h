@@ -6,11 +6,13 @@ template <class C> class SetNode
 private:
     C* data_field;
     SetNode<C>* next_field;
+    SetNode<C>* prev_field;
 
 public:
     SetNode() {
         this->data_field = nullptr;
         this->next_field = nullptr;
+        this->prev_field = nullptr;
     }
     
     ~SetNode() {
@@ -33,6 +35,14 @@ public:
     SetNode<C>* next() const {
         return this->next_field;
     }
+    
+    void setPrev(SetNode<C>* prev) {
+        this->prev_field = prev;
+    }
+    
+    SetNode<C>* prev() const {
+        return this->prev_field;
+    }
 };
 
 #endif // SETNODE_H
@@ -0,0 +1,123 @@
+#ifndef SHORTESTPATH_H
+#define SHORTESTPATH_H
+
+#include <climits>
+#include <unordered_map>
+#include <vector>
+
+#include "list.h"
+#include "listnode.h"
+#include "adjacentlist.h"
+#include "graph.h"
+
+// Shortest path from source to target in number of edges, found with a
+// bidirectional breadth-first search. One search follows the edges forward
+// from source, the other follows the incoming edges backward from target,
+// and each step expands whichever frontier is smaller by one level. The
+// search stops after the first level in which the two searches meet, so it
+// only explores a neighbourhood of each end instead of the whole component.
+//
+// On success path holds the vertices from source to target, both included.
+// Returns 0 when a path was found, 1 when target cannot be reached from
+// source (path is left empty), and -1 when either vertex is not in the
+// graph. Vertices are found by value, like the other Graph operations, and
+// the path holds the graph's own vertex objects. The graph is only read.
+template<typename T, typename Compare, typename Hash, typename AdjacentSet>
+int shortestPath(Graph<T, Compare, Hash, AdjacentSet>* graph,
+                 T* source,
+                 T* target,
+                 List<T>& path) {
+
+    typedef AdjacentList<T, Compare, Hash, AdjacentSet> Vertex;
+
+    // How each search reached a vertex: the neighbour it came from, towards
+    // its own end, and the number of edges from that end
+    struct Mark {
+        Vertex* parent;
+        int hops;
+        bool forward;
+    };
+
+    if (!graph || !source || !target) {
+        return -1; // Invalid parameters
+    }
+
+    ListNode<Vertex>* sourceNode = graph->findNodeByVertex(source);
+    ListNode<Vertex>* targetNode = graph->findNodeByVertex(target);
+
+    if (sourceNode == nullptr || targetNode == nullptr) {
+        return -1;  // Vertex not found
+    }
+
+    path.clear();
+
+    Vertex* first = sourceNode->data();
+    Vertex* last = targetNode->data();
+
+    if (first == last) {
+        path.insertUnchecked(path.tail(), first->vertex);
+        return 0;
+    }
+
+    std::unordered_map<Vertex*, Mark> marks;
+    std::vector<Vertex*> forwardFrontier(1, first);
+    std::vector<Vertex*> backwardFrontier(1, last);
+    std::vector<Vertex*> next;
+    marks[first] = Mark{nullptr, 0, true};
+    marks[last] = Mark{nullptr, 0, false};
+
+    // Best meeting edge so far, from meetFrom (reached forward) to meetTo
+    // (reached backward)
+    Vertex* meetFrom = nullptr;
+    Vertex* meetTo = nullptr;
+    int bestLength = INT_MAX;
+
+    while (meetFrom == nullptr && !forwardFrontier.empty() && !backwardFrontier.empty()) {
+        bool forward = forwardFrontier.size() <= backwardFrontier.size();
+        std::vector<Vertex*>& frontier = forward ? forwardFrontier : backwardFrontier;
+        next.clear();
+
+        // Expand the whole level, keeping the shortest meeting found in it
+        for (Vertex* current : frontier) {
+            int hops = marks[current].hops;
+            AdjacentSet& neighbours = forward ? current->adjacent : current->incoming;
+
+            for (auto member = neighbours.head(); member != nullptr; member = member->next()) {
+                ListNode<Vertex>* node = graph->findNodeByVertex(member->data());
+                if (node == nullptr) {
+                    continue;
+                }
+
+                Vertex* neighbour = node->data();
+                auto found = marks.find(neighbour);
+
+                if (found == marks.end()) {
+                    marks[neighbour] = Mark{current, hops + 1, forward};
+                    next.push_back(neighbour);
+                } else if (found->second.forward != forward && hops + 1 + found->second.hops < bestLength) {
+                    bestLength = hops + 1 + found->second.hops;
+                    meetFrom = forward ? current : neighbour;
+                    meetTo = forward ? neighbour : current;
+                }
+            }
+        }
+
+        frontier.swap(next);
+    }
+
+    if (meetFrom == nullptr) {
+        return 1;  // The searches never met
+    }
+
+    // Walk back from the meeting edge to source, then on to target
+    for (Vertex* vertex = meetFrom; vertex != nullptr; vertex = marks[vertex].parent) {
+        path.insertUnchecked(nullptr, vertex->vertex);
+    }
+    for (Vertex* vertex = meetTo; vertex != nullptr; vertex = marks[vertex].parent) {
+        path.insertUnchecked(path.tail(), vertex->vertex);
+    }
+
+    return 0;
+}
+
+#endif // SHORTESTPATH_H
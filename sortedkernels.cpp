@@ -0,0 +1,6 @@
+#include "sortedkernels.h"
+
+// This file is mostly empty because the kernels are inline functions
+// that must be in the header file.
+// Including this file in the project for consistency with
+// the project structure.
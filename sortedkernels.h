@@ -0,0 +1,375 @@
+#ifndef SORTEDKERNELS_H
+#define SORTEDKERNELS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+// Set algebra kernels over sorted, duplicate free uint32_t arrays, such as
+// FlatSet keys or the neighbour IDs of a vertex. Each operation has a
+// scalar merge, an SSE4.2 and an AVX2 version; the plain entry points pick
+// the widest one the CPU supports at run time, so the library can be built
+// without -mavx2 and still use AVX2 where it is available.
+//
+// The vector versions compare a block of a against a block of b all
+// against all (4x4 lanes for SSE, 8x8 for AVX2) and then advance the block
+// with the smaller maximum, so each step consumes a whole block of one
+// input without branching on individual elements.
+//
+// Output arrays must have room for the largest possible result: min(na, nb)
+// for intersections, na for differences and na + nb for unions.
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SORTEDKERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+// Instruction set used by a kernel
+enum SimdLevel { SimdScalar, SimdSse42, SimdAvx2 };
+
+// Widest instruction set supported by this CPU, detected once
+inline SimdLevel detectSimdLevel() {
+#ifdef SORTEDKERNELS_X86
+    static const SimdLevel level = []() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return SimdAvx2;
+        }
+        if (__builtin_cpu_supports("sse4.2")) {
+            return SimdSse42;
+        }
+        return SimdScalar;
+    }();
+    return level;
+#else
+    return SimdScalar;
+#endif
+}
+
+// Kernel internals; use the sorted* functions below
+namespace sortedkernels_detail {
+
+// Write the value or the position in a of each selected element
+template<bool Positions> inline size_t store(const uint32_t* a, size_t i, uint32_t* out, size_t n) {
+    out[n] = Positions ? static_cast<uint32_t>(i) : a[i];
+    return n + 1;
+}
+
+// Emit the elements of the block at a + i whose bit is set in mask
+template<bool Positions> inline size_t storeMask(const uint32_t* a, size_t i, unsigned mask, uint32_t* out, size_t n) {
+    while (mask != 0) {
+        n = store<Positions>(a, i + __builtin_ctz(mask), out, n);
+        mask &= mask - 1;
+    }
+    return n;
+}
+
+// Scalar merge; Found selects the elements of a that are in b (intersection)
+// or not found in b (difference)
+template<bool Positions, bool Found>
+inline size_t filterScalar(const uint32_t* a, size_t i, size_t na, const uint32_t* b, size_t j, size_t nb, uint32_t* out, size_t n) {
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+            if (!Found) {
+                n = store<Positions>(a, i, out, n);
+            }
+            i++;
+        } else if (b[j] < a[i]) {
+            j++;
+        } else {
+            if (Found) {
+                n = store<Positions>(a, i, out, n);
+            }
+            i++;
+            j++;
+        }
+    }
+    if (!Found) {
+        for (; i < na; i++) {
+            n = store<Positions>(a, i, out, n);
+        }
+    }
+    return n;
+}
+
+inline size_t countScalar(const uint32_t* a, size_t i, size_t na, const uint32_t* b, size_t j, size_t nb, size_t count) {
+    while (i < na && j < nb) {
+        // Branch free advance: both move on a match
+        uint32_t x = a[i];
+        uint32_t y = b[j];
+        count += x == y;
+        i += x <= y;
+        j += y <= x;
+    }
+    return count;
+}
+
+// Union of a[i..na), b[j..nb) and an optional sorted carry block, skipping
+// values equal to the last one written
+inline size_t unionScalar(const uint32_t* a, size_t i, size_t na, const uint32_t* b, size_t j, size_t nb,
+                          const uint32_t* carry, size_t nc, uint32_t* out, size_t n) {
+    size_t k = 0;
+    while (i < na || j < nb || k < nc) {
+        uint32_t value = UINT32_MAX;
+        if (i < na) {
+            value = std::min(value, a[i]);
+        }
+        if (j < nb) {
+            value = std::min(value, b[j]);
+        }
+        if (k < nc) {
+            value = std::min(value, carry[k]);
+        }
+
+        if (n == 0 || out[n - 1] != value) {
+            out[n++] = value;
+        }
+
+        // Consume every copy of value
+        if (i < na && a[i] == value) {
+            i++;
+        }
+        if (j < nb && b[j] == value) {
+            j++;
+        }
+        if (k < nc && carry[k] == value) {
+            k++;
+        }
+    }
+    return n;
+}
+
+#ifdef SORTEDKERNELS_X86
+
+// Bit i set when lane i of the a block equals any lane of the b block
+__attribute__((target("sse4.2"))) inline unsigned matchSse(__m128i va, __m128i vb) {
+    __m128i cmp = _mm_cmpeq_epi32(va, vb);
+    cmp = _mm_or_si128(cmp, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+    cmp = _mm_or_si128(cmp, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+    cmp = _mm_or_si128(cmp, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+    return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(cmp)));
+}
+
+__attribute__((target("avx2"))) inline unsigned matchAvx2(__m256i va, __m256i vb) {
+    // Four in-lane rotations of b and of b with its 128-bit halves
+    // swapped cover all 64 pairs
+    __m256i swapped = _mm256_permute2x128_si256(vb, vb, 1);
+    __m256i cmp = _mm256_cmpeq_epi32(va, vb);
+    cmp = _mm256_or_si256(cmp, _mm256_cmpeq_epi32(va, swapped));
+    cmp = _mm256_or_si256(cmp, _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+    cmp = _mm256_or_si256(cmp, _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(swapped, _MM_SHUFFLE(0, 3, 2, 1))));
+    cmp = _mm256_or_si256(cmp, _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+    cmp = _mm256_or_si256(cmp, _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(swapped, _MM_SHUFFLE(1, 0, 3, 2))));
+    cmp = _mm256_or_si256(cmp, _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+    cmp = _mm256_or_si256(cmp, _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(swapped, _MM_SHUFFLE(2, 1, 0, 3))));
+    return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(cmp)));
+}
+
+// Block loop shared by intersection, difference and count. The match mask
+// of the current a block accumulates over the b blocks it is compared
+// with and is consumed when the a block is retired. Whatever is left when
+// either input runs out of full blocks is finished by the scalar merge,
+// restarting b at the first element not below the current a block.
+#define SORTEDKERNELS_BLOCK_LOOP(WIDTH, LOAD, MATCH, RETIRE)                        \
+    size_t i = 0;                                                                   \
+    size_t j = 0;                                                                   \
+    unsigned found = 0;                                                             \
+    while (i + WIDTH <= na && j + WIDTH <= nb) {                                    \
+        found |= MATCH(LOAD(a + i), LOAD(b + j));                                   \
+        uint32_t amax = a[i + WIDTH - 1];                                           \
+        uint32_t bmax = b[j + WIDTH - 1];                                           \
+        if (amax <= bmax) {                                                         \
+            RETIRE;                                                                 \
+            found = 0;                                                              \
+            i += WIDTH;                                                             \
+        }                                                                           \
+        if (bmax <= amax) {                                                         \
+            j += WIDTH;                                                             \
+        }                                                                           \
+    }                                                                               \
+    if (i < na) {                                                                   \
+        j = std::lower_bound(b, b + nb, a[i]) - b;                                  \
+    }
+
+__attribute__((target("sse4.2"))) inline __m128i loadSse(const uint32_t* p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+__attribute__((target("avx2"))) inline __m256i loadAvx2(const uint32_t* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+template<bool Positions, bool Found>
+__attribute__((target("sse4.2"))) inline size_t filterSse(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out) {
+    size_t n = 0;
+    SORTEDKERNELS_BLOCK_LOOP(4, loadSse, matchSse,
+                             n = storeMask<Positions>(a, i, Found ? found : (~found & 0xFu), out, n))
+    return filterScalar<Positions, Found>(a, i, na, b, j, nb, out, n);
+}
+
+template<bool Positions, bool Found>
+__attribute__((target("avx2"))) inline size_t filterAvx2(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out) {
+    size_t n = 0;
+    SORTEDKERNELS_BLOCK_LOOP(8, loadAvx2, matchAvx2,
+                             n = storeMask<Positions>(a, i, Found ? found : (~found & 0xFFu), out, n))
+    return filterScalar<Positions, Found>(a, i, na, b, j, nb, out, n);
+}
+
+__attribute__((target("sse4.2,popcnt"))) inline size_t countSse(const uint32_t* a, size_t na, const uint32_t* b, size_t nb) {
+    size_t count = 0;
+    SORTEDKERNELS_BLOCK_LOOP(4, loadSse, matchSse, count += __builtin_popcount(found))
+    return countScalar(a, i, na, b, j, nb, count);
+}
+
+__attribute__((target("avx2,popcnt"))) inline size_t countAvx2(const uint32_t* a, size_t na, const uint32_t* b, size_t nb) {
+    size_t count = 0;
+    SORTEDKERNELS_BLOCK_LOOP(8, loadAvx2, matchAvx2, count += __builtin_popcount(found))
+    return countScalar(a, i, na, b, j, nb, count);
+}
+
+#undef SORTEDKERNELS_BLOCK_LOOP
+
+// Sort the 8 values of two sorted 4-lane vectors: vmin gets the 4
+// smallest and vmax the 4 largest, both in ascending order
+__attribute__((target("sse4.2"))) inline void mergeSse(__m128i va, __m128i vb, __m128i* vmin, __m128i* vmax) {
+    __m128i lo = _mm_min_epu32(va, vb);
+    __m128i hi = _mm_max_epu32(va, vb);
+    for (int round = 0; round < 3; round++) {
+        lo = _mm_alignr_epi8(lo, lo, 4);
+        __m128i t = _mm_min_epu32(lo, hi);
+        hi = _mm_max_epu32(lo, hi);
+        lo = t;
+    }
+    *vmin = _mm_alignr_epi8(lo, lo, 4);
+    *vmax = hi;
+}
+
+// Vectorized union: a 4-lane merge network emits the smallest 4 values
+// seen so far, and duplicates are dropped against the previous value
+__attribute__((target("sse4.2"))) inline size_t unionSse(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out) {
+    if (na < 4 || nb < 4) {
+        return unionScalar(a, 0, na, b, 0, nb, nullptr, 0, out, 0);
+    }
+
+    __m128i vmin;
+    __m128i vmax;
+    mergeSse(loadSse(a), loadSse(b), &vmin, &vmax);
+    size_t i = 4;
+    size_t j = 4;
+    size_t n = 0;
+    uint32_t last = 0;
+    alignas(16) uint32_t lanes[4];
+
+    while (true) {
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), vmin);
+        for (int k = 0; k < 4; k++) {
+            if (n == 0 || lanes[k] != last) {
+                last = lanes[k];
+                out[n++] = last;
+            }
+        }
+
+        // Refill from the input whose next value is smaller. If that input
+        // has no full block left, taking the other one could emit values
+        // out of order, so the rest is merged by the scalar loop.
+        bool takeA = j == nb || (i < na && a[i] <= b[j]);
+        if (takeA && i + 4 <= na) {
+            mergeSse(loadSse(a + i), vmax, &vmin, &vmax);
+            i += 4;
+        } else if (!takeA && j + 4 <= nb) {
+            mergeSse(loadSse(b + j), vmax, &vmin, &vmax);
+            j += 4;
+        } else {
+            break;
+        }
+    }
+
+    // Everything stored so far is <= the carried block and both tails
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), vmax);
+    return unionScalar(a, i, na, b, j, nb, lanes, 4, out, n);
+}
+
+#endif // SORTEDKERNELS_X86
+
+template<bool Positions, bool Found>
+inline size_t filter(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out, SimdLevel level) {
+#ifdef SORTEDKERNELS_X86
+    if (level >= SimdAvx2) {
+        return filterAvx2<Positions, Found>(a, na, b, nb, out);
+    }
+    if (level >= SimdSse42) {
+        return filterSse<Positions, Found>(a, na, b, nb, out);
+    }
+#endif
+    (void)level;
+    return filterScalar<Positions, Found>(a, 0, na, b, 0, nb, out, 0);
+}
+
+// Clamp a requested level to what the CPU supports
+inline SimdLevel usableLevel(SimdLevel level) {
+    SimdLevel supported = detectSimdLevel();
+    return level < supported ? level : supported;
+}
+
+} // namespace sortedkernels_detail
+
+// Values in both a and b; returns the number written to out
+inline size_t sortedIntersect(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out,
+                              SimdLevel level = detectSimdLevel()) {
+    using namespace sortedkernels_detail;
+    return filter<false, true>(a, na, b, nb, out, usableLevel(level));
+}
+
+// Positions in a of the values also in b
+inline size_t sortedIntersectPositions(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out,
+                                       SimdLevel level = detectSimdLevel()) {
+    using namespace sortedkernels_detail;
+    return filter<true, true>(a, na, b, nb, out, usableLevel(level));
+}
+
+// Values in a but not in b
+inline size_t sortedDifference(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out,
+                               SimdLevel level = detectSimdLevel()) {
+    using namespace sortedkernels_detail;
+    return filter<false, false>(a, na, b, nb, out, usableLevel(level));
+}
+
+// Positions in a of the values not in b
+inline size_t sortedDifferencePositions(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out,
+                                        SimdLevel level = detectSimdLevel()) {
+    using namespace sortedkernels_detail;
+    return filter<true, false>(a, na, b, nb, out, usableLevel(level));
+}
+
+// Number of values in both a and b, without writing them anywhere
+inline size_t sortedIntersectCount(const uint32_t* a, size_t na, const uint32_t* b, size_t nb,
+                                   SimdLevel level = detectSimdLevel()) {
+    using namespace sortedkernels_detail;
+    level = usableLevel(level);
+#ifdef SORTEDKERNELS_X86
+    if (level >= SimdAvx2) {
+        return countAvx2(a, na, b, nb);
+    }
+    if (level >= SimdSse42) {
+        return countSse(a, na, b, nb);
+    }
+#endif
+    return countScalar(a, 0, na, b, 0, nb, 0);
+}
+
+// Values in a or b, in order and without duplicates. The AVX2 level uses
+// the SSE merge network, since wider bitonic merges do not pay off for
+// the typical adjacency sizes.
+inline size_t sortedUnion(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out,
+                          SimdLevel level = detectSimdLevel()) {
+    using namespace sortedkernels_detail;
+    level = usableLevel(level);
+#ifdef SORTEDKERNELS_X86
+    if (level >= SimdSse42) {
+        return unionSse(a, na, b, nb, out);
+    }
+#endif
+    return unionScalar(a, 0, na, b, 0, nb, nullptr, 0, out, 0);
+}
+
+#endif // SORTEDKERNELS_H
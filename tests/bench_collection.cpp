@@ -0,0 +1,282 @@
+#include <QtTest/QtTest>
+#include <vector>
+#include "../list.h"
+#include "../queue.h"
+#include "../set.h"
+#include "../flatset.h"
+#include "../bitset.h"
+
+// Benchmarks for the collection classes. Each benchmark is data driven over
+// the collection size so the per-operation cost can be compared as the
+// collection grows. Run with "./tests/bench_collection" from the build folder.
+class BenchCollection : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Ownership lookups against collections of growing size
+    void benchmarkHasOwnership_data();
+    void benchmarkHasOwnership();
+
+    // Release and retake ownership of an element (List::remove path)
+    void benchmarkOwnershipChurn_data();
+    void benchmarkOwnershipChurn();
+
+    // Enqueue/dequeue pairs on queues of growing length
+    void benchmarkEnqueue_data();
+    void benchmarkEnqueue();
+
+    // Set algebra on list backed, hash backed, sorted array and bitset sets
+    void benchmarkUnionSet_data();
+    void benchmarkUnionSet();
+    void benchmarkIntersectionSet_data();
+    void benchmarkIntersectionSet();
+    void benchmarkDifferenceSet_data();
+    void benchmarkDifferenceSet();
+
+private:
+    void addSizeRows();
+    void addSetRows();
+};
+
+// Hash for the int sets, consistent with std::equal_to<int>
+struct IntHash
+{
+    size_t operator()(const int &value) const
+    {
+        return std::hash<int>()(value);
+    }
+};
+
+// Which set algebra operation a benchmark runs
+enum SetOperation { Union, Intersection, Difference };
+
+// Which set implementation a benchmark runs on
+enum SetBackend { ListSet, HashSet, SortedSet, DenseSet };
+
+// Time one set operation on two half-overlapping sets of the given size
+template <class S> static void benchmarkSetOperation(SetOperation operation, int size)
+{
+    std::vector<int> values(size + size / 2);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int>(i);
+    }
+
+    // set1 = [0, size), set2 = [size / 2, size + size / 2)
+    S set1;
+    S set2;
+    for (int i = 0; i < size; i++) {
+        set1.insert(&values[i]);
+        set2.insert(&values[i + size / 2]);
+    }
+
+    int resultSize = 0;
+    QBENCHMARK {
+        S result;
+        switch (operation) {
+        case Union:
+            S::unionSet(&result, &set1, &set2);
+            break;
+        case Intersection:
+            S::intersectionSet(&result, &set1, &set2);
+            break;
+        case Difference:
+            S::differenceSet(&result, &set1, &set2);
+            break;
+        }
+        resultSize = result.getSize();
+    }
+
+    QVERIFY(resultSize > 0);
+}
+
+// Number of operations timed per benchmark iteration
+static const int OPS_PER_ITERATION = 1000;
+
+void BenchCollection::addSizeRows()
+{
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("1k") << 1000;
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+    QTest::newRow("1M") << 1000000;
+}
+
+void BenchCollection::benchmarkHasOwnership_data()
+{
+    addSizeRows();
+}
+
+void BenchCollection::benchmarkHasOwnership()
+{
+    QFETCH(int, size);
+
+    List<int> list;
+    std::vector<int*> probes;
+
+    for (int i = 0; i < size; i++) {
+        int* value = new int(i);
+        list.insert(nullptr, value, true);
+
+        // Sample the owned elements evenly so lookups touch the whole table
+        if (i % (size / OPS_PER_ITERATION) == 0) {
+            probes.push_back(value);
+        }
+    }
+
+    int found = 0;
+    QBENCHMARK {
+        for (int* probe : probes) {
+            if (list.hasOwnership(probe)) {
+                found++;
+            }
+        }
+    }
+
+    QVERIFY(found > 0);
+}
+
+void BenchCollection::benchmarkOwnershipChurn_data()
+{
+    addSizeRows();
+}
+
+void BenchCollection::benchmarkOwnershipChurn()
+{
+    QFETCH(int, size);
+
+    List<int> list;
+    std::vector<int*> probes;
+
+    for (int i = 0; i < size; i++) {
+        int* value = new int(i);
+        list.insert(nullptr, value, true);
+
+        if (i % (size / OPS_PER_ITERATION) == 0) {
+            probes.push_back(value);
+        }
+    }
+
+    QBENCHMARK {
+        for (int* probe : probes) {
+            list.releaseOwnership(probe);
+            list.takeOwnership(probe);
+        }
+    }
+
+    QVERIFY(list.hasOwnership(probes.front()));
+}
+
+void BenchCollection::benchmarkEnqueue_data()
+{
+    addSizeRows();
+}
+
+void BenchCollection::benchmarkEnqueue()
+{
+    QFETCH(int, size);
+
+    Queue<int> queue;
+    std::vector<int> values(size);
+
+    for (int& value : values) {
+        queue.enqueue(&value);
+    }
+
+    // Each pair keeps the length constant, so the cost per enqueue should
+    // not depend on how long the queue is
+    int* removed = nullptr;
+    QBENCHMARK {
+        for (int i = 0; i < OPS_PER_ITERATION; i++) {
+            queue.enqueue(&values[i]);
+            queue.dequeue(&removed);
+        }
+    }
+
+    QCOMPARE(queue.getSize(), size);
+}
+
+void BenchCollection::addSetRows()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("backend");
+
+    // The list backed set is O(n*m), so it stops at 10k elements
+    QTest::newRow("list/100") << 100 << int(ListSet);
+    QTest::newRow("list/1k") << 1000 << int(ListSet);
+    QTest::newRow("list/10k") << 10000 << int(ListSet);
+    QTest::newRow("hash/100") << 100 << int(HashSet);
+    QTest::newRow("hash/1k") << 1000 << int(HashSet);
+    QTest::newRow("hash/10k") << 10000 << int(HashSet);
+    QTest::newRow("hash/100k") << 100000 << int(HashSet);
+    QTest::newRow("flat/100") << 100 << int(SortedSet);
+    QTest::newRow("flat/1k") << 1000 << int(SortedSet);
+    QTest::newRow("flat/10k") << 10000 << int(SortedSet);
+    QTest::newRow("flat/100k") << 100000 << int(SortedSet);
+    QTest::newRow("bits/100") << 100 << int(DenseSet);
+    QTest::newRow("bits/1k") << 1000 << int(DenseSet);
+    QTest::newRow("bits/10k") << 10000 << int(DenseSet);
+    QTest::newRow("bits/100k") << 100000 << int(DenseSet);
+}
+
+// Run a set operation on the implementation selected by the row
+static void runSetOperation(SetOperation operation, int size, int backend)
+{
+    switch (backend) {
+    case ListSet:
+        benchmarkSetOperation<Set<int>>(operation, size);
+        break;
+    case HashSet:
+        benchmarkSetOperation<Set<int, std::equal_to<int>, IntHash>>(operation, size);
+        break;
+    case SortedSet:
+        benchmarkSetOperation<FlatSet<int>>(operation, size);
+        break;
+    case DenseSet:
+        benchmarkSetOperation<BitSet<int>>(operation, size);
+        break;
+    }
+}
+
+void BenchCollection::benchmarkUnionSet_data()
+{
+    addSetRows();
+}
+
+void BenchCollection::benchmarkUnionSet()
+{
+    QFETCH(int, size);
+    QFETCH(int, backend);
+
+    runSetOperation(Union, size, backend);
+}
+
+void BenchCollection::benchmarkIntersectionSet_data()
+{
+    addSetRows();
+}
+
+void BenchCollection::benchmarkIntersectionSet()
+{
+    QFETCH(int, size);
+    QFETCH(int, backend);
+
+    runSetOperation(Intersection, size, backend);
+}
+
+void BenchCollection::benchmarkDifferenceSet_data()
+{
+    addSetRows();
+}
+
+void BenchCollection::benchmarkDifferenceSet()
+{
+    QFETCH(int, size);
+    QFETCH(int, backend);
+
+    runSetOperation(Difference, size, backend);
+}
+
+QTEST_APPLESS_MAIN(BenchCollection)
+#include "bench_collection.moc"
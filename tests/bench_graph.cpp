@@ -0,0 +1,600 @@
+#include <QtTest/QtTest>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../graph.h"
+#include "../csrgraph.h"
+#include "../bfs.h"
+#include "../parallelbfs.h"
+#include "../multisourcebfs.h"
+#include "../shortestpath.h"
+#include "../scc.h"
+#include "../topologicalsort.h"
+#include "../connectedcomponents.h"
+#include "../dijkstra.h"
+#include "../deltastepping.h"
+#include "../pagerank.h"
+#include "../triangles.h"
+#include "../traversalstate.h"
+#include "../threadpool.h"
+#include "../bfsvertex.h"
+#include "randomgraph.h"
+
+// Benchmarks for the graph traversals. All of them search the same random
+// graph, built once, so the rows can be compared directly. Run with
+// "./tests/bench_graph" from the build folder.
+class BenchGraph : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Sequential BFS on the list-based graph and on the CSR snapshot
+    void benchmarkBfs_data();
+    void benchmarkBfs();
+
+    // Parallel BFS from 1 thread up to one per hardware thread
+    void benchmarkParallelBfs_data();
+    void benchmarkParallelBfs();
+
+    // 64 searches one at a time and as one multi-source search
+    void benchmarkMultiSourceBfs_data();
+    void benchmarkMultiSourceBfs();
+
+    // One s-t path from a full bfs and from a bidirectional search
+    void benchmarkShortestPath_data();
+    void benchmarkShortestPath();
+
+    // Strongly connected components, sequential and on 1 thread up to one
+    // per hardware thread
+    void benchmarkScc_data();
+    void benchmarkScc();
+
+    // Topological sort of a random DAG, sequential and on 1 thread up to
+    // one per hardware thread
+    void benchmarkTopologicalSort_data();
+    void benchmarkTopologicalSort();
+
+    // Weakly connected components with union-find, and with Afforest on
+    // 1 thread up to one per hardware thread
+    void benchmarkConnectedComponents_data();
+    void benchmarkConnectedComponents();
+
+    // Dijkstra across a weighted grid with a binary, 4-ary and 8-ary heap
+    void benchmarkDijkstra_data();
+    void benchmarkDijkstra();
+
+    // Dijkstra against delta-stepping across the weighted grid, with a
+    // narrow and a wide delta on 1 thread up to one per hardware thread
+    void benchmarkDeltaStepping_data();
+    void benchmarkDeltaStepping();
+
+    // 20 PageRank iterations with the scalar and the widest gather loop,
+    // on 1 thread up to one per hardware thread
+    void benchmarkPageRank_data();
+    void benchmarkPageRank();
+
+    // Triangle counts and clustering coefficients on 1 thread up to one
+    // per hardware thread
+    void benchmarkTriangles_data();
+    void benchmarkTriangles();
+};
+
+// Random graph with VERTEX_COUNT vertices and an average out-degree of
+// AVERAGE_DEGREE, plus its CSR snapshot. An acyclic fixture only has edges
+// from lower to higher vertex numbers.
+static const int VERTEX_COUNT = 1 << 18;
+static const int AVERAGE_DEGREE = 8;
+
+struct GraphFixture
+{
+    BfsGraph graph;
+    std::vector<int> values;
+    std::vector<BfsVertex<int> *> vertices;
+    std::unique_ptr<CsrGraph<BfsVertex<int>>> csr;
+
+    explicit GraphFixture(bool acyclic = false) : values(VERTEX_COUNT), vertices(VERTEX_COUNT)
+    {
+        for (int i = 0; i < VERTEX_COUNT; i++) {
+            this->values[i] = i;
+            this->vertices[i] = new BfsVertex<int>(&this->values[i]);
+            this->graph.insertVertex(this->vertices[i], true);
+        }
+
+        std::mt19937 rng(1);
+        std::uniform_int_distribution<int> pick(0, VERTEX_COUNT - 1);
+        for (int i = 0; i < VERTEX_COUNT * AVERAGE_DEGREE; i++) {
+            int from = pick(rng);
+            int to = pick(rng);
+            if (acyclic && from >= to) {
+                std::swap(from, to);
+                if (from == to) {
+                    continue;
+                }
+            }
+            this->graph.insertEdge(this->vertices[from], this->vertices[to]);
+        }
+
+        this->csr.reset(new CsrGraph<BfsVertex<int>>(this->graph));
+    }
+};
+
+static GraphFixture &fixture()
+{
+    static GraphFixture graph;
+    return graph;
+}
+
+static GraphFixture &acyclicFixture()
+{
+    static GraphFixture graph(true);
+    return graph;
+}
+
+// Road-like GRID_SIDE x GRID_SIDE grid, each vertex joined both ways to
+// its neighbours left, right, above and below by edges of random weight,
+// plus its CSR snapshot. Separate from GraphFixture because shortest paths
+// on it are long and its degrees are low and even.
+static const int GRID_SIDE = 1024;
+
+struct GridFixture
+{
+    BfsGraph graph;
+    std::vector<int> values;
+    std::vector<BfsVertex<int> *> vertices;
+    std::unique_ptr<CsrGraph<BfsVertex<int>>> csr;
+
+    GridFixture() : values(GRID_SIDE * GRID_SIDE), vertices(GRID_SIDE * GRID_SIDE)
+    {
+        for (int i = 0; i < GRID_SIDE * GRID_SIDE; i++) {
+            this->values[i] = i;
+            this->vertices[i] = new BfsVertex<int>(&this->values[i]);
+            this->graph.insertVertex(this->vertices[i], true);
+        }
+
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<double> weigh(1.0, 10.0);
+        for (int row = 0; row < GRID_SIDE; row++) {
+            for (int column = 0; column < GRID_SIDE; column++) {
+                int i = row * GRID_SIDE + column;
+                if (column + 1 < GRID_SIDE) {
+                    this->graph.insertWeightedEdge(this->vertices[i], this->vertices[i + 1], weigh(rng));
+                    this->graph.insertWeightedEdge(this->vertices[i + 1], this->vertices[i], weigh(rng));
+                }
+                if (row + 1 < GRID_SIDE) {
+                    this->graph.insertWeightedEdge(this->vertices[i], this->vertices[i + GRID_SIDE], weigh(rng));
+                    this->graph.insertWeightedEdge(this->vertices[i + GRID_SIDE], this->vertices[i], weigh(rng));
+                }
+            }
+        }
+
+        this->csr.reset(new CsrGraph<BfsVertex<int>>(this->graph));
+    }
+};
+
+static GridFixture &gridFixture()
+{
+    static GridFixture grid;
+    return grid;
+}
+
+// Which structure and search a benchmarkBfs row runs
+enum BfsVariant { ListGraph, CsrTopDown, CsrDirectionOptimizing };
+
+void BenchGraph::benchmarkBfs_data()
+{
+    QTest::addColumn<int>("variant");
+
+    QTest::newRow("graph") << static_cast<int>(ListGraph);
+    QTest::newRow("csr top-down") << static_cast<int>(CsrTopDown);
+    QTest::newRow("csr direction-optimizing") << static_cast<int>(CsrDirectionOptimizing);
+}
+
+void BenchGraph::benchmarkBfs()
+{
+    QFETCH(int, variant);
+
+    GraphFixture &graph = fixture();
+    List<BfsVertex<int>> hops;
+    QBENCHMARK {
+        switch (variant) {
+        case ListGraph:
+            bfs(&graph.graph, graph.vertices[0], hops);
+            break;
+        case CsrTopDown:
+            bfs(graph.csr.get(), graph.vertices[0], hops);
+            break;
+        case CsrDirectionOptimizing:
+            bfs(graph.csr.get(), graph.vertices[0], hops, BfsDirectionOptimizing);
+            break;
+        }
+    }
+
+    QVERIFY(hops.getSize() > VERTEX_COUNT / 2);
+}
+
+void BenchGraph::benchmarkParallelBfs_data()
+{
+    QTest::addColumn<int>("threads");
+
+    unsigned maxThreads = std::thread::hardware_concurrency();
+    if (maxThreads == 0) {
+        maxThreads = 1;
+    }
+
+    // Powers of two, then the full machine
+    std::vector<unsigned> counts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads);
+
+    for (unsigned threads : counts) {
+        std::string name = std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+        QTest::newRow(name.c_str()) << static_cast<int>(threads);
+    }
+}
+
+void BenchGraph::benchmarkParallelBfs()
+{
+    QFETCH(int, threads);
+
+    GraphFixture &graph = fixture();
+    ThreadPool pool(threads);
+    List<BfsVertex<int>> hops;
+    QBENCHMARK {
+        parallelBfs(graph.csr.get(), graph.vertices[0], hops, pool);
+    }
+
+    QVERIFY(hops.getSize() > VERTEX_COUNT / 2);
+}
+
+void BenchGraph::benchmarkMultiSourceBfs_data()
+{
+    QTest::addColumn<bool>("batched");
+
+    QTest::newRow("64 x bfs") << false;
+    QTest::newRow("multi-source") << true;
+}
+
+void BenchGraph::benchmarkMultiSourceBfs()
+{
+    QFETCH(bool, batched);
+
+    GraphFixture &graph = fixture();
+    std::vector<uint32_t> sources;
+    for (uint32_t s = 0; s < 64; s++) {
+        sources.push_back(s * 4099 % VERTEX_COUNT);
+    }
+
+    // Sum the hops so both variants consume every result
+    long long total = 0;
+    QBENCHMARK {
+        total = 0;
+        if (batched) {
+            multiSourceBfs(graph.csr.get(), sources, [&total](size_t, uint32_t, int hops) {
+                total += hops;
+            });
+        } else {
+            BfsState state;
+            for (uint32_t source : sources) {
+                bfs(graph.csr.get(), source, state);
+                for (uint32_t id : state.reached) {
+                    total += state.getHops(id);
+                }
+            }
+        }
+    }
+
+    QVERIFY(total > 0);
+}
+
+void BenchGraph::benchmarkShortestPath_data()
+{
+    QTest::addColumn<bool>("bidirectional");
+
+    QTest::newRow("bfs") << false;
+    QTest::newRow("bidirectional") << true;
+}
+
+void BenchGraph::benchmarkShortestPath()
+{
+    QFETCH(bool, bidirectional);
+
+    GraphFixture &graph = fixture();
+    BfsVertex<int> *source = graph.vertices[0];
+    BfsVertex<int> *target = graph.vertices[VERTEX_COUNT / 2];
+
+    int length = -1;
+    QBENCHMARK {
+        if (bidirectional) {
+            List<BfsVertex<int>> path;
+            shortestPath(&graph.graph, source, target, path);
+            length = path.getSize() - 1;
+        } else {
+            List<BfsVertex<int>> hops;
+            bfs(&graph.graph, source, hops);
+            length = target->getHops();
+        }
+    }
+
+    QVERIFY(length > 0);
+}
+
+void BenchGraph::benchmarkScc_data()
+{
+    QTest::addColumn<int>("threads");
+
+    // 0 threads runs the sequential Tarjan
+    QTest::newRow("tarjan") << 0;
+
+    unsigned maxThreads = std::thread::hardware_concurrency();
+    if (maxThreads == 0) {
+        maxThreads = 1;
+    }
+
+    std::vector<unsigned> counts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads);
+
+    for (unsigned threads : counts) {
+        std::string name = "parallel, " + std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+        QTest::newRow(name.c_str()) << static_cast<int>(threads);
+    }
+}
+
+void BenchGraph::benchmarkScc()
+{
+    QFETCH(int, threads);
+
+    GraphFixture &graph = fixture();
+    std::unique_ptr<ThreadPool> pool(threads > 0 ? new ThreadPool(threads) : nullptr);
+    Condensation condensation;
+    QBENCHMARK {
+        if (pool) {
+            parallelScc(graph.csr.get(), condensation, *pool);
+        } else {
+            scc(graph.csr.get(), condensation);
+        }
+    }
+
+    QVERIFY(condensation.getComponentCount() > 0);
+}
+
+void BenchGraph::benchmarkTopologicalSort_data()
+{
+    QTest::addColumn<int>("threads");
+
+    // 0 threads runs the sequential sort
+    QTest::newRow("kahn") << 0;
+
+    unsigned maxThreads = std::thread::hardware_concurrency();
+    if (maxThreads == 0) {
+        maxThreads = 1;
+    }
+
+    std::vector<unsigned> counts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads);
+
+    for (unsigned threads : counts) {
+        std::string name = "parallel, " + std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+        QTest::newRow(name.c_str()) << static_cast<int>(threads);
+    }
+}
+
+void BenchGraph::benchmarkTopologicalSort()
+{
+    QFETCH(int, threads);
+
+    GraphFixture &graph = acyclicFixture();
+    std::unique_ptr<ThreadPool> pool(threads > 0 ? new ThreadPool(threads) : nullptr);
+    TopologicalOrder result;
+    int sorted = -1;
+    QBENCHMARK {
+        if (pool) {
+            sorted = parallelTopologicalSort(graph.csr.get(), result, *pool);
+        } else {
+            sorted = topologicalSort(graph.csr.get(), result);
+        }
+    }
+
+    QCOMPARE(sorted, 0);
+}
+
+void BenchGraph::benchmarkConnectedComponents_data()
+{
+    QTest::addColumn<int>("threads");
+
+    // 0 threads runs the sequential union-find
+    QTest::newRow("union-find") << 0;
+
+    unsigned maxThreads = std::thread::hardware_concurrency();
+    if (maxThreads == 0) {
+        maxThreads = 1;
+    }
+
+    std::vector<unsigned> counts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads);
+
+    for (unsigned threads : counts) {
+        std::string name = "afforest, " + std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+        QTest::newRow(name.c_str()) << static_cast<int>(threads);
+    }
+}
+
+void BenchGraph::benchmarkConnectedComponents()
+{
+    QFETCH(int, threads);
+
+    GraphFixture &graph = fixture();
+    std::unique_ptr<ThreadPool> pool(threads > 0 ? new ThreadPool(threads) : nullptr);
+    Components components;
+    QBENCHMARK {
+        if (pool) {
+            parallelConnectedComponents(graph.csr.get(), components, *pool);
+        } else {
+            connectedComponents(graph.csr.get(), components);
+        }
+    }
+
+    QVERIFY(components.getComponentCount() > 0);
+}
+
+void BenchGraph::benchmarkDijkstra_data()
+{
+    QTest::addColumn<int>("arity");
+
+    QTest::newRow("binary heap") << 2;
+    QTest::newRow("4-ary heap") << 4;
+    QTest::newRow("8-ary heap") << 8;
+}
+
+void BenchGraph::benchmarkDijkstra()
+{
+    QFETCH(int, arity);
+
+    // From the middle of the grid, so the search reaches every vertex
+    GridFixture &grid = gridFixture();
+    uint32_t source = grid.csr->idOf(grid.vertices[GRID_SIDE * GRID_SIDE / 2 + GRID_SIDE / 2]);
+    ShortestPathTree tree;
+    QBENCHMARK {
+        if (arity == 2) {
+            dijkstra<2>(grid.csr.get(), source, tree);
+        } else if (arity == 4) {
+            dijkstra<4>(grid.csr.get(), source, tree);
+        } else {
+            dijkstra<8>(grid.csr.get(), source, tree);
+        }
+    }
+
+    QVERIFY(tree.isReached(0));
+}
+
+void BenchGraph::benchmarkDeltaStepping_data()
+{
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<double>("delta");
+
+    QTest::newRow("dijkstra") << 0 << 0.0;
+
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> counts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads);
+
+    // The grid's weights are between 1 and 10
+    for (double delta : {2.0, 16.0}) {
+        for (unsigned threads : counts) {
+            std::string name = "delta " + std::to_string(static_cast<int>(delta)) + ", " +
+                               std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+            QTest::newRow(name.c_str()) << static_cast<int>(threads) << delta;
+        }
+    }
+}
+
+void BenchGraph::benchmarkDeltaStepping()
+{
+    QFETCH(int, threads);
+    QFETCH(double, delta);
+
+    GridFixture &grid = gridFixture();
+    uint32_t source = grid.csr->idOf(grid.vertices[GRID_SIDE * GRID_SIDE / 2 + GRID_SIDE / 2]);
+    std::unique_ptr<ThreadPool> pool(threads > 0 ? new ThreadPool(threads) : nullptr);
+    ShortestPathTree tree;
+    QBENCHMARK {
+        if (pool) {
+            deltaStepping(grid.csr.get(), source, delta, tree, *pool);
+        } else {
+            dijkstra(grid.csr.get(), source, tree);
+        }
+    }
+
+    QVERIFY(tree.isReached(0));
+}
+
+void BenchGraph::benchmarkPageRank_data()
+{
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<int>("level");
+
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> counts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads);
+
+    std::vector<SimdLevel> levels(1, SimdScalar);
+    if (detectSimdLevel() >= SimdAvx2) {
+        levels.push_back(SimdAvx2);
+    }
+
+    for (SimdLevel level : levels) {
+        for (unsigned threads : counts) {
+            std::string name = std::string(level == SimdScalar ? "scalar, " : "avx2, ") +
+                               std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+            QTest::newRow(name.c_str()) << static_cast<int>(threads) << static_cast<int>(level);
+        }
+    }
+}
+
+void BenchGraph::benchmarkPageRank()
+{
+    QFETCH(int, threads);
+    QFETCH(int, level);
+
+    // A tolerance of 0 never converges, so every row runs 20 iterations
+    GraphFixture &graph = fixture();
+    ThreadPool pool(threads);
+    PageRank result;
+    QBENCHMARK {
+        pageRank(graph.csr.get(), result, pool, 0.85, 0.0, 20, static_cast<SimdLevel>(level));
+    }
+
+    QCOMPARE(result.getIterationCount(), 20);
+}
+
+void BenchGraph::benchmarkTriangles_data()
+{
+    QTest::addColumn<int>("threads");
+
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> counts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads);
+
+    for (unsigned threads : counts) {
+        std::string name = std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+        QTest::newRow(name.c_str()) << static_cast<int>(threads);
+    }
+}
+
+void BenchGraph::benchmarkTriangles()
+{
+    QFETCH(int, threads);
+
+    GraphFixture &graph = fixture();
+    ThreadPool pool(threads);
+    Triangles triangles;
+    QBENCHMARK {
+        countTriangles(graph.csr.get(), triangles, pool);
+    }
+
+    QVERIFY(triangles.getTriangleCount() > 0);
+}
+
+QTEST_APPLESS_MAIN(BenchGraph)
+#include "bench_graph.moc"
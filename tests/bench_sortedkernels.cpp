@@ -0,0 +1,161 @@
+#include <QtTest/QtTest>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "../sortedkernels.h"
+
+// Microbenchmarks for the sorted uint32_t set kernels. Every operation is
+// timed with the scalar merge and each SIMD level the CPU supports, over a
+// range of size ratios between the two inputs. Run with
+// "./tests/bench_sortedkernels" from the build folder.
+class BenchSortedKernels : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void benchmarkIntersect_data();
+    void benchmarkIntersect();
+    void benchmarkIntersectCount_data();
+    void benchmarkIntersectCount();
+    void benchmarkDifference_data();
+    void benchmarkDifference();
+    void benchmarkUnion_data();
+    void benchmarkUnion();
+
+private:
+    void addRatioRows();
+};
+
+// Size of the larger input
+static const size_t LARGE_SIZE = 1 << 16;
+
+// Sorted, duplicate free values drawn from [0, range)
+static std::vector<uint32_t> randomSorted(std::mt19937& rng, size_t count, uint32_t range)
+{
+    std::uniform_int_distribution<uint32_t> pick(0, range - 1);
+    std::vector<uint32_t> values(count);
+    for (uint32_t& value : values) {
+        value = pick(rng);
+    }
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    return values;
+}
+
+// Inputs for one row: the larger input has LARGE_SIZE values, the smaller
+// one LARGE_SIZE / ratio, both drawn from the same range so about a
+// quarter of the smaller input is in the larger one
+struct KernelInputs
+{
+    std::vector<uint32_t> a;
+    std::vector<uint32_t> b;
+    std::vector<uint32_t> out;
+
+    KernelInputs(int ratio)
+    {
+        std::mt19937 rng(ratio);
+        uint32_t range = static_cast<uint32_t>(LARGE_SIZE * 4);
+        this->a = randomSorted(rng, LARGE_SIZE / ratio, range);
+        this->b = randomSorted(rng, LARGE_SIZE, range);
+        this->out.resize(this->a.size() + this->b.size());
+    }
+};
+
+void BenchSortedKernels::addRatioRows()
+{
+    QTest::addColumn<int>("ratio");
+    QTest::addColumn<int>("level");
+
+    static const char* names[] = {"scalar", "sse4.2", "avx2"};
+    for (int ratio : {1, 4, 16, 64, 256}) {
+        for (int level = SimdScalar; level <= detectSimdLevel(); level++) {
+            std::string name = std::string(names[level]) + "/1:" + std::to_string(ratio);
+            QTest::newRow(name.c_str()) << ratio << level;
+        }
+    }
+}
+
+void BenchSortedKernels::benchmarkIntersect_data()
+{
+    addRatioRows();
+}
+
+void BenchSortedKernels::benchmarkIntersect()
+{
+    QFETCH(int, ratio);
+    QFETCH(int, level);
+
+    KernelInputs inputs(ratio);
+    size_t n = 0;
+    QBENCHMARK {
+        n = sortedIntersect(inputs.a.data(), inputs.a.size(), inputs.b.data(), inputs.b.size(),
+                            inputs.out.data(), static_cast<SimdLevel>(level));
+    }
+
+    QVERIFY(n > 0);
+}
+
+void BenchSortedKernels::benchmarkIntersectCount_data()
+{
+    addRatioRows();
+}
+
+void BenchSortedKernels::benchmarkIntersectCount()
+{
+    QFETCH(int, ratio);
+    QFETCH(int, level);
+
+    KernelInputs inputs(ratio);
+    size_t n = 0;
+    QBENCHMARK {
+        n = sortedIntersectCount(inputs.a.data(), inputs.a.size(), inputs.b.data(), inputs.b.size(),
+                                 static_cast<SimdLevel>(level));
+    }
+
+    QVERIFY(n > 0);
+}
+
+void BenchSortedKernels::benchmarkDifference_data()
+{
+    addRatioRows();
+}
+
+void BenchSortedKernels::benchmarkDifference()
+{
+    QFETCH(int, ratio);
+    QFETCH(int, level);
+
+    KernelInputs inputs(ratio);
+    size_t n = 0;
+    QBENCHMARK {
+        n = sortedDifference(inputs.a.data(), inputs.a.size(), inputs.b.data(), inputs.b.size(),
+                             inputs.out.data(), static_cast<SimdLevel>(level));
+    }
+
+    QVERIFY(n > 0);
+}
+
+void BenchSortedKernels::benchmarkUnion_data()
+{
+    addRatioRows();
+}
+
+void BenchSortedKernels::benchmarkUnion()
+{
+    QFETCH(int, ratio);
+    QFETCH(int, level);
+
+    KernelInputs inputs(ratio);
+    size_t n = 0;
+    QBENCHMARK {
+        n = sortedUnion(inputs.a.data(), inputs.a.size(), inputs.b.data(), inputs.b.size(),
+                        inputs.out.data(), static_cast<SimdLevel>(level));
+    }
+
+    QVERIFY(n >= inputs.b.size());
+}
+
+QTEST_APPLESS_MAIN(BenchSortedKernels)
+#include "bench_sortedkernels.moc"
@@ -0,0 +1,135 @@
+#ifndef RANDOMGRAPH_H
+#define RANDOMGRAPH_H
+
+// Random graphs shared by the graph algorithm tests. Vertex i holds the
+// value i, and the same seed always gives the same graph.
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+#include "../graph.h"
+#include "../bfsvertex.h"
+#include "../dfsvertex.h"
+
+struct IntHash
+{
+    size_t operator()(const int &value) const
+    {
+        return std::hash<int>()(value);
+    }
+};
+
+typedef Graph<int, std::equal_to<int>, IntHash> IntGraph;
+
+// Vertex functors comparing the int payload of a BfsVertex or DfsVertex
+struct CompareValue
+{
+    template<class V> bool operator()(const V &v1, const V &v2) const
+    {
+        return *v1.data == *v2.data;
+    }
+};
+
+struct HashValue
+{
+    template<class V> size_t operator()(const V &v) const
+    {
+        return std::hash<int>()(*v.data);
+    }
+};
+
+typedef Graph<BfsVertex<int>, CompareValue, HashValue> BfsGraph;
+typedef Graph<DfsVertex<int>, CompareValue, HashValue> DfsGraph;
+
+// Fill a graph with count vertices numbered 0..count-1 and random edges
+template<class G>
+void buildRandomGraph(G &graph, std::vector<int> &values, int count, int edges, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    values.resize(count);
+
+    for (int i = 0; i < count; i++) {
+        values[i] = i;
+        graph.insertVertex(&values[i]);
+    }
+
+    std::uniform_int_distribution<int> pick(0, count - 1);
+    for (int i = 0; i < edges; i++) {
+        int a = pick(rng);
+        int b = pick(rng);
+        graph.insertEdge(&values[a], &values[b]);
+    }
+}
+
+// Same, with edges weighing between 0 and maxWeight
+template<class G>
+void buildRandomGraph(G &graph, std::vector<int> &values, int count, int edges, double maxWeight, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    values.resize(count);
+
+    for (int i = 0; i < count; i++) {
+        values[i] = i;
+        graph.insertVertex(&values[i]);
+    }
+
+    std::uniform_int_distribution<int> pick(0, count - 1);
+    std::uniform_real_distribution<double> weigh(0, maxWeight);
+    for (int i = 0; i < edges; i++) {
+        int a = pick(rng);
+        int b = pick(rng);
+        double w = weigh(rng);
+        graph.insertWeightedEdge(&values[a], &values[b], w);
+    }
+}
+
+// Same, with BfsVertex or DfsVertex vertices over values, owned by the graph
+template<class G, class V>
+void buildRandomGraph(G &graph, std::vector<int> &values, std::vector<V *> &vertices, int count, int edges, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    values.resize(count);
+    vertices.resize(count);
+
+    for (int i = 0; i < count; i++) {
+        values[i] = i;
+        vertices[i] = new V(&values[i]);
+        graph.insertVertex(vertices[i], true);
+    }
+
+    std::uniform_int_distribution<int> pick(0, count - 1);
+    for (int i = 0; i < edges; i++) {
+        int a = pick(rng);
+        int b = pick(rng);
+        graph.insertEdge(vertices[a], vertices[b]);
+    }
+}
+
+// Fill a graph with count vertices and random edges that all go forward
+// in a shuffled order of the vertices, so the graph has no cycle
+template<class G>
+void buildRandomDag(G &graph, std::vector<int> &values, int count, int edges, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    values.resize(count);
+
+    std::vector<int> rank(count);
+    for (int i = 0; i < count; i++) {
+        values[i] = i;
+        rank[i] = i;
+        graph.insertVertex(&values[i]);
+    }
+    std::shuffle(rank.begin(), rank.end(), rng);
+
+    std::uniform_int_distribution<int> pick(0, count - 1);
+    for (int i = 0; i < edges; i++) {
+        int a = pick(rng);
+        int b = pick(rng);
+        if (a != b) {
+            graph.insertEdge(&values[rank[std::min(a, b)]], &values[rank[std::max(a, b)]]);
+        }
+    }
+}
+
+#endif // RANDOMGRAPH_H
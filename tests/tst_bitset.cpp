@@ -0,0 +1,416 @@
+#include <QtTest/QtTest>
+#include <limits>
+#include <vector>
+#include "../bitset.h"
+#include "../graph.h"
+#include "../bfs.h"
+#include "../bfsvertex.h"
+
+class TestBitSet : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Runs before each test function
+    void init();
+
+    // Runs after each test function
+    void cleanup();
+
+    // Test functions - each test is a separate function
+    void testInsert();
+    void testRemove();
+    void testIsMember();
+    void testOutOfRangeKeys();
+    void testIteration();
+    void testOwnership();
+    void testUnion();
+    void testIntersection();
+    void testDifference();
+    void testSubsetAndEqual();
+    void testCustomKey();
+    void testGraphAdjacency();
+};
+
+// Record keyed by its id
+struct Item
+{
+    int id;
+    int payload;
+};
+
+struct ItemKey
+{
+    size_t operator()(const Item &item) const
+    {
+        return static_cast<size_t>(item.id);
+    }
+};
+
+// Vertex functors for graphs with bitset adjacency
+struct CompareVertex
+{
+    bool operator()(const BfsVertex<int> &v1, const BfsVertex<int> &v2) const
+    {
+        return *v1.data == *v2.data;
+    }
+};
+
+struct VertexKey
+{
+    size_t operator()(const BfsVertex<int> &v) const
+    {
+        return static_cast<size_t>(*v.data);
+    }
+};
+
+// Collect the members of a set in iteration order
+template<class S> static std::vector<int> members(const S &set)
+{
+    std::vector<int> values;
+    for (auto node = set.head(); node != nullptr; node = node->next()) {
+        values.push_back(*node->data());
+    }
+    return values;
+}
+
+void TestBitSet::init()
+{
+    // Setup code that runs before each test
+}
+
+void TestBitSet::cleanup()
+{
+    // Cleanup code that runs after each test
+}
+
+void TestBitSet::testInsert()
+{
+    BitSet<int> set;
+    int values[] = {5, 1, 100, 64, 63};
+
+    QCOMPARE(set.getSize(), 0);
+    QVERIFY(set.head() == nullptr);
+    QVERIFY(set.tail() == nullptr);
+
+    for (int &value : values) {
+        set.insert(&value);
+    }
+    QCOMPARE(set.getSize(), 5);
+
+    // The set grows to cover the largest key
+    QVERIFY(set.getCapacity() > 100);
+
+    // An equal key is a duplicate even if it is a different object
+    int duplicate = 64;
+    set.insert(&duplicate);
+    QCOMPARE(set.getSize(), 5);
+    QVERIFY(set.head()->next()->next()->next()->data() == &values[3]);
+
+    // Null elements have no key and are ignored
+    set.insert(nullptr);
+    QCOMPARE(set.getSize(), 5);
+}
+
+void TestBitSet::testRemove()
+{
+    BitSet<int> set;
+    int values[] = {1, 2, 3, 200};
+
+    for (int &value : values) {
+        set.insert(&value);
+    }
+
+    // Remove by key
+    int two = 2;
+    QVERIFY(set.remove(&two));
+    QVERIFY(set.remove(&values[3]));
+    QCOMPARE(members(set), std::vector<int>({1, 3}));
+
+    // Removing a missing key fails, including keys beyond the capacity
+    int missing = 5000;
+    QVERIFY(!set.remove(&two));
+    QVERIFY(!set.remove(&missing));
+    QVERIFY(!set.remove(nullptr));
+    QCOMPARE(set.getSize(), 2);
+}
+
+void TestBitSet::testIsMember()
+{
+    BitSet<int> set;
+    std::vector<int> values(500);
+
+    // Insert the multiples of three
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int>(i) * 3;
+        set.insert(&values[i]);
+    }
+
+    for (int i = 0; i < 2000; i++) {
+        QCOMPARE(set.isMember(&i), i < 1500 && i % 3 == 0);
+    }
+    QVERIFY(!set.isMember(nullptr));
+}
+
+void TestBitSet::testOutOfRangeKeys()
+{
+    BitSet<int> set;
+    int values[] = {-1, -64, std::numeric_limits<int>::min()};
+    int three = 3;
+
+    // Negative keys are not members and inserting them changes nothing,
+    // not even ownership
+    set.insert(&three);
+    for (int &value : values) {
+        set.insert(&value, true);
+    }
+    QCOMPARE(set.getSize(), 1);
+    QCOMPARE(members(set), std::vector<int>({3}));
+    QVERIFY(set.getCapacity() < 1000);
+    QVERIFY(!set.hasOwnership(&values[0]));
+    QVERIFY(!set.isMember(&values[0]));
+    QVERIFY(!set.isMember(&values[2]));
+    QVERIFY(!set.remove(&values[1]));
+
+    // The same goes for keys at or above maxKey from a custom KeyOf
+    BitSet<Item, ItemKey> items;
+    Item huge = {-5, 0};
+    items.insert(&huge);
+    QCOMPARE(items.getSize(), 0);
+    QVERIFY(!items.isMember(&huge));
+    QVERIFY(!items.remove(&huge));
+    QVERIFY((BitSet<Item, ItemKey>::maxKey > size_t(1) << 32));
+}
+
+void TestBitSet::testIteration()
+{
+    BitSet<int> set;
+    int values[] = {700, 0, 63, 64, 65, 127, 128, 300};
+
+    // Reserving up front means inserts never reallocate
+    set.reserve(701);
+    size_t capacity = set.getCapacity();
+    QVERIFY(capacity >= 701);
+
+    for (int &value : values) {
+        set.insert(&value);
+    }
+    QCOMPARE(set.getCapacity(), capacity);
+
+    // Members are visited in key order across word boundaries
+    QCOMPARE(members(set), std::vector<int>({0, 63, 64, 65, 127, 128, 300, 700}));
+    QCOMPARE(*set.head()->data(), 0);
+    QCOMPARE(*set.tail()->data(), 700);
+    QVERIFY(set.tail()->next() == nullptr);
+
+    // Growing keeps iteration working
+    int large = 5000;
+    set.insert(&large);
+    QCOMPARE(*set.tail()->data(), 5000);
+    QCOMPARE(members(set).size(), size_t(9));
+}
+
+void TestBitSet::testOwnership()
+{
+    BitSet<int> set;
+    int *owned = new int(1);
+    int *notOwned = new int(2);
+
+    set.insert(owned, true);
+    set.insert(notOwned, false);
+
+    QVERIFY(set.hasOwnership(owned));
+    QVERIFY(!set.hasOwnership(notOwned));
+
+    // Removing releases ownership, so the caller deletes the element
+    QVERIFY(set.remove(owned));
+    QVERIFY(!set.hasOwnership(owned));
+    delete owned;
+
+    // Owned elements still in the set are deleted with it
+    {
+        BitSet<int> ownerSet;
+        ownerSet.insert(new int(3), true);
+        ownerSet.insert(new int(400), true);
+        QCOMPARE(ownerSet.getSize(), 2);
+    }
+
+    delete notOwned;
+}
+
+void TestBitSet::testUnion()
+{
+    BitSet<int> set1;
+    BitSet<int> set2;
+    BitSet<int> result;
+    int values1[] = {1, 3, 70, 200};
+    int values2[] = {2, 3, 70, 1000};
+
+    for (int &value : values1) {
+        set1.insert(&value);
+    }
+    for (int &value : values2) {
+        set2.insert(&value);
+    }
+
+    BitSet<int>::unionSet(&result, &set1, &set2);
+    QCOMPARE(members(result), std::vector<int>({1, 2, 3, 70, 200, 1000}));
+    QCOMPARE(result.getSize(), 6);
+
+    // Shared keys take the element of set1
+    int three = 3;
+    QVERIFY(result.head()->next()->next()->data() == &values1[1]);
+    QVERIFY(result.isMember(&three));
+
+    // Members already in the result are kept
+    BitSet<int> extra;
+    int seven = 7;
+    int other3 = 3;
+    extra.insert(&seven);
+    extra.insert(&other3);
+    BitSet<int>::unionSet(&extra, &set1, &set2);
+    QCOMPARE(extra.getSize(), 7);
+    QVERIFY(extra.head()->next()->next()->data() == &other3);
+}
+
+void TestBitSet::testIntersection()
+{
+    BitSet<int> set1;
+    BitSet<int> set2;
+    BitSet<int> result;
+    int values1[] = {1, 3, 70, 200};
+    int values2[] = {2, 3, 70, 1000};
+
+    for (int &value : values1) {
+        set1.insert(&value);
+    }
+    for (int &value : values2) {
+        set2.insert(&value);
+    }
+
+    BitSet<int>::intersectionSet(&result, &set1, &set2);
+    QCOMPARE(members(result), std::vector<int>({3, 70}));
+    QVERIFY(result.head()->data() == &values1[1]);
+
+    // Disjoint sets have an empty intersection
+    BitSet<int> none;
+    BitSet<int> empty;
+    BitSet<int>::intersectionSet(&none, &set1, &empty);
+    QCOMPARE(none.getSize(), 0);
+}
+
+void TestBitSet::testDifference()
+{
+    BitSet<int> set1;
+    BitSet<int> set2;
+    int values1[] = {1, 3, 70, 200};
+    int values2[] = {2, 3, 70, 1000};
+
+    for (int &value : values1) {
+        set1.insert(&value);
+    }
+    for (int &value : values2) {
+        set2.insert(&value);
+    }
+
+    BitSet<int> result;
+    BitSet<int>::differenceSet(&result, &set1, &set2);
+    QCOMPARE(members(result), std::vector<int>({1, 200}));
+
+    BitSet<int> reverse;
+    BitSet<int>::differenceSet(&reverse, &set2, &set1);
+    QCOMPARE(members(reverse), std::vector<int>({2, 1000}));
+}
+
+void TestBitSet::testSubsetAndEqual()
+{
+    BitSet<int> small;
+    BitSet<int> large;
+    int values[] = {1, 2, 3, 500};
+    int copies[] = {1, 2, 3, 500};
+
+    small.insert(&values[0]);
+    small.insert(&values[1]);
+    for (int &value : values) {
+        large.insert(&value);
+    }
+
+    QVERIFY(BitSet<int>::isSubset(&small, &large));
+    QVERIFY(!BitSet<int>::isSubset(&large, &small));
+    QVERIFY(!BitSet<int>::isEqualSet(&small, &large));
+
+    // A key beyond the end of the other set is not in it
+    BitSet<int> wide;
+    wide.insert(&values[3]);
+    QVERIFY(!BitSet<int>::isSubset(&wide, &small));
+
+    // Equality is by key, not by pointer, whatever the capacities
+    BitSet<int> same;
+    same.reserve(10000);
+    for (int &copy : copies) {
+        same.insert(&copy);
+    }
+    QVERIFY(BitSet<int>::isEqualSet(&large, &same));
+    QVERIFY(BitSet<int>::isEqualSet(&same, &large));
+
+    // The empty set is a subset of every set
+    BitSet<int> empty;
+    QVERIFY(BitSet<int>::isSubset(&empty, &small));
+}
+
+void TestBitSet::testCustomKey()
+{
+    BitSet<Item, ItemKey> set;
+    Item first = {10, 1};
+    Item second = {20, 2};
+    Item sameId = {10, 3};
+
+    set.insert(&first);
+    set.insert(&second);
+
+    // Elements with the same key are the same member
+    set.insert(&sameId);
+    QCOMPARE(set.getSize(), 2);
+    QVERIFY(set.isMember(&sameId));
+    QCOMPARE(set.head()->data()->payload, 1);
+
+    QVERIFY(set.remove(&sameId));
+    QVERIFY(!set.isMember(&first));
+    QCOMPARE(set.head()->data(), &second);
+}
+
+void TestBitSet::testGraphAdjacency()
+{
+    typedef BitSet<BfsVertex<int>, VertexKey> Neighbours;
+    Graph<BfsVertex<int>, CompareVertex, NoHash<BfsVertex<int>>, Neighbours> graph;
+    const int count = 100;
+    int values[count];
+    BfsVertex<int> *vertices[count];
+
+    for (int i = 0; i < count; i++) {
+        values[i] = i + 1;
+        vertices[i] = new BfsVertex<int>(&values[i]);
+        QCOMPARE(graph.insertVertex(vertices[i], true), 0);
+    }
+
+    // Each vertex points to the vertex with twice its value
+    for (int i = 0; 2 * (i + 1) <= count; i++) {
+        QCOMPARE(graph.insertEdge(vertices[i], vertices[2 * (i + 1) - 1]), 0);
+    }
+    QVERIFY(graph.isAdjacentGraph(vertices[2], vertices[5]));
+    QVERIFY(!graph.isAdjacentGraph(vertices[5], vertices[2]));
+
+    // 1 -> 2 -> 4 -> 8 -> 16 -> 32 -> 64
+    List<BfsVertex<int>> hops;
+    QCOMPARE(bfs(&graph, vertices[0], hops), 0);
+    QCOMPARE(vertices[63]->getHops(), 6);
+    QCOMPARE(vertices[2]->getHops(), -1);
+    QCOMPARE(hops.getSize(), 7);
+
+    BfsVertex<int> *target = vertices[1];
+    QCOMPARE(graph.removeEdge(vertices[0], &target), 0);
+    QVERIFY(!graph.isAdjacentGraph(vertices[0], vertices[1]));
+}
+
+QTEST_APPLESS_MAIN(TestBitSet)
+#include "tst_bitset.moc"
@@ -0,0 +1,529 @@
+#include <QtTest/QtTest>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../graph.h"
+#include "../csrgraph.h"
+#include "../bfs.h"
+#include "../dfs.h"
+#include "../bfsvertex.h"
+#include "../dfsvertex.h"
+#include "../traversalstate.h"
+#include "randomgraph.h"
+
+class TestCsrGraph : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Runs before each test function
+    void init();
+
+    // Runs after each test function
+    void cleanup();
+
+    // Test functions - each test is a separate function
+    void testSnapshot();
+    void testEqualNeighbourObjects();
+    void testSortNeighbours();
+    void testIncomingEdges();
+    void testWeights();
+    void testBfsMatchesGraph();
+    void testBfsUnknownStart();
+    void testDirectionOptimizingBfs_data();
+    void testDirectionOptimizingBfs();
+    void testDfsMatchesGraph();
+    void testDeepDfs();
+    void testExternalState();
+    void testConcurrentQueries();
+    void testReusedState();
+};
+
+void TestCsrGraph::init()
+{
+    // Setup code that runs before each test
+}
+
+void TestCsrGraph::cleanup()
+{
+    // Cleanup code that runs after each test
+}
+
+void TestCsrGraph::testSnapshot()
+{
+    BfsGraph graph;
+    int values[] = {10, 20, 30, 40};
+    BfsVertex<int> *vertices[4];
+
+    for (int i = 0; i < 4; i++) {
+        vertices[i] = new BfsVertex<int>(&values[i]);
+        graph.insertVertex(vertices[i], true);
+    }
+
+    graph.insertEdge(vertices[0], vertices[2]);
+    graph.insertEdge(vertices[0], vertices[1]);
+    graph.insertEdge(vertices[2], vertices[3]);
+    graph.insertEdge(vertices[3], vertices[0]);
+
+    CsrGraph<BfsVertex<int>> csr(graph);
+    QCOMPARE(csr.getVertexCount(), 4);
+    QCOMPARE(csr.getEdgeCount(), 4);
+
+    // IDs follow the order of the adjacency lists
+    for (uint32_t id = 0; id < 4; id++) {
+        QCOMPARE(csr.vertex(id), vertices[id]);
+        QCOMPARE(csr.idOf(vertices[id]), id);
+    }
+
+    // Neighbours keep the order of the adjacent sets
+    QCOMPARE(csr.degree(0), uint32_t(2));
+    QCOMPARE(csr.adjacentBegin(0)[0], uint32_t(2));
+    QCOMPARE(csr.adjacentBegin(0)[1], uint32_t(1));
+    QCOMPARE(csr.degree(1), uint32_t(0));
+    QVERIFY(csr.adjacentBegin(1) == csr.adjacentEnd(1));
+    QCOMPARE(csr.adjacentBegin(3)[0], uint32_t(0));
+
+    const uint32_t expectedOffsets[] = {0, 2, 2, 3, 4};
+    for (int i = 0; i < 5; i++) {
+        QCOMPARE(csr.getOffsets()[i], expectedOffsets[i]);
+    }
+
+    // Objects that are not vertices of the graph have no ID, even if equal
+    int ten = 10;
+    BfsVertex<int> copy(&ten);
+    QCOMPARE(csr.idOf(&copy), CsrGraph<BfsVertex<int>>::noVertex);
+    QCOMPARE(csr.idOf(nullptr), CsrGraph<BfsVertex<int>>::noVertex);
+}
+
+void TestCsrGraph::testEqualNeighbourObjects()
+{
+    BfsGraph graph;
+    int values[] = {1, 2};
+    int two = 2;
+    BfsVertex<int> *a = new BfsVertex<int>(&values[0]);
+    BfsVertex<int> *b = new BfsVertex<int>(&values[1]);
+    BfsVertex<int> equalToB(&two);
+
+    graph.insertVertex(a, true);
+    graph.insertVertex(b, true);
+
+    // The edge stores a different object that compares equal to b
+    QCOMPARE(graph.insertEdge(a, &equalToB), 0);
+
+    CsrGraph<BfsVertex<int>> csr(graph);
+    QCOMPARE(csr.getEdgeCount(), 1);
+    QCOMPARE(*csr.adjacentBegin(csr.idOf(a)), csr.idOf(b));
+}
+
+void TestCsrGraph::testSortNeighbours()
+{
+    BfsGraph graph;
+    std::vector<int> values;
+    std::vector<BfsVertex<int> *> vertices;
+    buildRandomGraph(graph, values, vertices, 50, 400, 3);
+
+    CsrGraph<BfsVertex<int>> csr(graph);
+    QCOMPARE(csr.getEdgeCount(), graph.getEdgeCount());
+    csr.sortNeighbours();
+
+    for (uint32_t id = 0; id < 50; id++) {
+        const uint32_t *begin = csr.adjacentBegin(id);
+        const uint32_t *end = csr.adjacentEnd(id);
+        QVERIFY(std::is_sorted(begin, end));
+
+        // Every edge of the graph is still there
+        for (const uint32_t *adj = begin; adj != end; adj++) {
+            QVERIFY(graph.isAdjacentGraph(csr.vertex(id), csr.vertex(*adj)));
+        }
+    }
+}
+
+void TestCsrGraph::testIncomingEdges()
+{
+    BfsGraph graph;
+    std::vector<int> values;
+    std::vector<BfsVertex<int> *> vertices;
+    buildRandomGraph(graph, values, vertices, 60, 500, 8);
+
+    CsrGraph<BfsVertex<int>> csr(graph);
+    uint32_t incoming = 0;
+
+    for (uint32_t id = 0; id < 60; id++) {
+        const uint32_t *begin = csr.incomingBegin(id);
+        const uint32_t *end = csr.incomingEnd(id);
+        QCOMPARE(csr.inDegree(id), static_cast<uint32_t>(end - begin));
+        QCOMPARE(static_cast<int>(csr.inDegree(id)), graph.getInDegree(csr.vertex(id)));
+        QVERIFY(std::is_sorted(begin, end));
+
+        // Every reversed edge is an edge of the graph
+        for (const uint32_t *source = begin; source != end; source++) {
+            QVERIFY(graph.isAdjacentGraph(csr.vertex(*source), csr.vertex(id)));
+        }
+        incoming += csr.inDegree(id);
+    }
+
+    QCOMPARE(static_cast<int>(incoming), csr.getEdgeCount());
+}
+
+void TestCsrGraph::testWeights()
+{
+    BfsGraph graph;
+    std::vector<int> values;
+    std::vector<BfsVertex<int> *> vertices;
+    buildRandomGraph(graph, values, vertices, 40, 0, 5);
+
+    // Weigh each edge by its endpoints so the weight can be checked after
+    // sorting, except an unweighted self-loop
+    graph.insertEdge(vertices[0], vertices[0]);
+    std::mt19937 rng(6);
+    std::uniform_int_distribution<int> pick(0, 39);
+    for (int i = 0; i < 300; i++) {
+        int from = pick(rng);
+        int to = pick(rng);
+        graph.insertWeightedEdge(vertices[from], vertices[to], from * 100.0 + to);
+    }
+
+    CsrGraph<BfsVertex<int>> csr(graph);
+    for (int pass = 0; pass < 2; pass++) {
+        for (uint32_t id = 0; id < 40; id++) {
+            QCOMPARE(csr.weightsEnd(id) - csr.weightsBegin(id), csr.adjacentEnd(id) - csr.adjacentBegin(id));
+
+            const double *weight = csr.weightsBegin(id);
+            for (const uint32_t *adj = csr.adjacentBegin(id); adj != csr.adjacentEnd(id); adj++, weight++) {
+                double expected = id == 0 && *adj == 0 ? 1.0 : id * 100.0 + *adj;
+                QCOMPARE(*weight, expected);
+            }
+        }
+
+        // Weights move with their neighbours
+        csr.sortNeighbours();
+    }
+}
+
+void TestCsrGraph::testBfsMatchesGraph()
+{
+    BfsGraph graph;
+    std::vector<int> values;
+    std::vector<BfsVertex<int> *> vertices;
+    buildRandomGraph(graph, values, vertices, 300, 600, 11);
+
+    List<BfsVertex<int>> graphHops;
+    QCOMPARE(bfs(&graph, vertices[0], graphHops), 0);
+
+    std::vector<int> expectedHops;
+    std::vector<VertexColor> expectedColors;
+    for (BfsVertex<int> *vertex : vertices) {
+        expectedHops.push_back(vertex->getHops());
+        expectedColors.push_back(vertex->getColor());
+        vertex->setHops(-7);
+    }
+
+    CsrGraph<BfsVertex<int>> csr(graph);
+    List<BfsVertex<int>> csrHops;
+    QCOMPARE(bfs(&csr, vertices[0], csrHops), 0);
+
+    for (size_t i = 0; i < vertices.size(); i++) {
+        QCOMPARE(vertices[i]->getHops(), expectedHops[i]);
+        QCOMPARE(vertices[i]->getColor(), expectedColors[i]);
+    }
+
+    // Same reachable vertices in the same order
+    QCOMPARE(csrHops.getSize(), graphHops.getSize());
+    ListNode<BfsVertex<int>> *expected = graphHops.head();
+    for (ListNode<BfsVertex<int>> *node = csrHops.head(); node != nullptr; node = node->next()) {
+        QCOMPARE(node->data(), expected->data());
+        expected = expected->next();
+    }
+}
+
+void TestCsrGraph::testBfsUnknownStart()
+{
+    BfsGraph graph;
+    int value = 1;
+    graph.insertVertex(new BfsVertex<int>(&value), true);
+
+    CsrGraph<BfsVertex<int>> csr(graph);
+    List<BfsVertex<int>> hops;
+    BfsVertex<int> stranger(&value);
+    QCOMPARE(bfs(&csr, &stranger, hops), -1);
+    QCOMPARE(bfs(&csr, static_cast<BfsVertex<int> *>(nullptr), hops), -1);
+}
+
+void TestCsrGraph::testDirectionOptimizingBfs_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("edges");
+    QTest::addColumn<int>("hubs");
+
+    // Sparse graphs stay top-down, dense and hub-heavy ones go bottom-up
+    QTest::newRow("sparse") << 400 << 500 << 0;
+    QTest::newRow("dense") << 300 << 6000 << 0;
+    QTest::newRow("hubs") << 2000 << 4000 << 4;
+    QTest::newRow("tiny") << 3 << 2 << 0;
+}
+
+void TestCsrGraph::testDirectionOptimizingBfs()
+{
+    QFETCH(int, count);
+    QFETCH(int, edges);
+    QFETCH(int, hubs);
+
+    BfsGraph graph;
+    std::vector<int> values;
+    std::vector<BfsVertex<int> *> vertices;
+    buildRandomGraph(graph, values, vertices, count, edges, count + edges);
+
+    // A few hubs linked both ways with most of the graph give a low
+    // diameter, like a power-law graph
+    for (int hub = 0; hub < hubs; hub++) {
+        for (int i = hub; i < count; i += 2) {
+            graph.insertEdge(vertices[hub], vertices[i]);
+            graph.insertEdge(vertices[i], vertices[hub]);
+        }
+    }
+
+    CsrGraph<BfsVertex<int>> csr(graph);
+
+    for (int start : {0, count / 2, count - 1}) {
+        List<BfsVertex<int>> graphHops;
+        QCOMPARE(bfs(&graph, vertices[start], graphHops), 0);
+
+        std::vector<int> expected;
+        for (BfsVertex<int> *vertex : vertices) {
+            expected.push_back(vertex->getHops());
+            vertex->setHops(-7);
+        }
+
+        List<BfsVertex<int>> csrHops;
+        QCOMPARE(bfs(&csr, vertices[start], csrHops, BfsDirectionOptimizing), 0);
+        QCOMPARE(csrHops.getSize(), graphHops.getSize());
+
+        for (size_t i = 0; i < vertices.size(); i++) {
+            QCOMPARE(vertices[i]->getHops(), expected[i]);
+            QCOMPARE(vertices[i]->getColor(), expected[i] == -1 ? white : black);
+        }
+    }
+}
+
+void TestCsrGraph::testDfsMatchesGraph()
+{
+    DfsGraph graph;
+    std::vector<int> values;
+    std::vector<DfsVertex<int> *> vertices;
+    buildRandomGraph(graph, values, vertices, 200, 300, 5);
+
+    List<DfsVertex<int>, CompareValue> graphOrder;
+    QCOMPARE(dfs(&graph, graphOrder), 0);
+
+    for (DfsVertex<int> *vertex : vertices) {
+        vertex->setColor(white);
+    }
+
+    CsrGraph<DfsVertex<int>> csr(graph);
+    List<DfsVertex<int>, CompareValue> csrOrder;
+    QCOMPARE(dfs(&csr, csrOrder), 0);
+
+    // Same finishing order and every vertex black
+    QCOMPARE(csrOrder.getSize(), graphOrder.getSize());
+    ListNode<DfsVertex<int>> *expected = graphOrder.head();
+    for (ListNode<DfsVertex<int>> *node = csrOrder.head(); node != nullptr; node = node->next()) {
+        QCOMPARE(node->data(), expected->data());
+        QCOMPARE(node->data()->getColor(), black);
+        expected = expected->next();
+    }
+}
+
+void TestCsrGraph::testDeepDfs()
+{
+    // A long chain would need one stack frame per vertex with recursion
+    DfsGraph graph;
+    const int count = 200000;
+    std::vector<int> values(count);
+    std::vector<DfsVertex<int> *> vertices(count);
+
+    for (int i = 0; i < count; i++) {
+        values[i] = i;
+        vertices[i] = new DfsVertex<int>(&values[i]);
+        graph.insertVertex(vertices[i], true);
+    }
+    for (int i = 0; i + 1 < count; i++) {
+        graph.insertEdge(vertices[i], vertices[i + 1]);
+    }
+
+    CsrGraph<DfsVertex<int>> csr(graph);
+    List<DfsVertex<int>, CompareValue> ordered;
+    QCOMPARE(dfs(&csr, ordered), 0);
+
+    // Topological order of a chain is the chain itself
+    QCOMPARE(ordered.getSize(), count);
+    QCOMPARE(ordered.head()->data(), vertices[0]);
+    QCOMPARE(ordered.tail()->data(), vertices[count - 1]);
+}
+
+void TestCsrGraph::testExternalState()
+{
+    // The same random graph twice, once with plain int vertices
+    BfsGraph graph;
+    std::vector<int> values;
+    std::vector<BfsVertex<int> *> vertices;
+    buildRandomGraph(graph, values, vertices, 300, 700, 21);
+
+    IntGraph plain;
+    for (int &value : values) {
+        plain.insertVertex(&value);
+    }
+    for (auto node = graph.getAdjacencyListHead(); node != nullptr; node = node->next()) {
+        for (auto member = node->data()->adjacent.head(); member != nullptr; member = member->next()) {
+            plain.insertEdge(node->data()->vertex->data, member->data()->data);
+        }
+    }
+
+    CsrGraph<BfsVertex<int>> csr(graph);
+    CsrGraph<int> plainCsr(plain);
+
+    List<BfsVertex<int>> hops;
+    QCOMPARE(bfs(&csr, vertices[5], hops), 0);
+
+    BfsState state;
+    QCOMPARE(bfs(&plainCsr, plainCsr.idOf(&values[5]), state), 0);
+    QCOMPARE(static_cast<int>(state.reached.size()), hops.getSize());
+    QCOMPARE(state.reached[0], plainCsr.idOf(&values[5]));
+
+    for (uint32_t id = 0; id < 300; id++) {
+        QCOMPARE(state.getHops(id), vertices[id]->getHops());
+        QCOMPARE(state.getColor(id), vertices[id]->getColor());
+    }
+
+    // Discovery order visits the levels in turn
+    for (size_t i = 1; i < state.reached.size(); i++) {
+        QVERIFY(state.getHops(state.reached[i - 1]) <= state.getHops(state.reached[i]));
+    }
+
+    // A reused state starts over, and bad sources are rejected
+    QCOMPARE(bfs(&plainCsr, plainCsr.idOf(&values[7]), state, BfsDirectionOptimizing), 0);
+    QCOMPARE(state.getHops(plainCsr.idOf(&values[7])), 0);
+    QCOMPARE(bfs(&plainCsr, 300u, state), -1);
+
+    // DFS finishing order, read backwards, is the dfs list order
+    DfsGraph dfsGraph;
+    std::vector<int> dfsValues;
+    std::vector<DfsVertex<int> *> dfsVertices;
+    buildRandomGraph(dfsGraph, dfsValues, dfsVertices, 100, 150, 4);
+
+    CsrGraph<DfsVertex<int>> dfsCsr(dfsGraph);
+    List<DfsVertex<int>, CompareValue> ordered;
+    QCOMPARE(dfs(&dfsCsr, ordered), 0);
+
+    DfsState dfsState;
+    QCOMPARE(dfs(&dfsCsr, dfsState), 0);
+    QCOMPARE(static_cast<int>(dfsState.finished.size()), ordered.getSize());
+
+    ListNode<DfsVertex<int>> *node = ordered.head();
+    for (size_t i = dfsState.finished.size(); i > 0; i--) {
+        QCOMPARE(dfsCsr.vertex(dfsState.finished[i - 1]), node->data());
+        QCOMPARE(dfsState.getColor(dfsState.finished[i - 1]), black);
+        node = node->next();
+    }
+}
+
+void TestCsrGraph::testConcurrentQueries()
+{
+    BfsGraph graph;
+    std::vector<int> values;
+    std::vector<BfsVertex<int> *> vertices;
+    buildRandomGraph(graph, values, vertices, 2000, 6000, 13);
+
+    CsrGraph<BfsVertex<int>> csr(graph);
+    const int queries = 4;
+
+    // Reference results, one search at a time
+    std::vector<BfsState> expected(queries);
+    for (int q = 0; q < queries; q++) {
+        bfs(&csr, static_cast<uint32_t>(q * 100), expected[q]);
+    }
+
+    // The same searches at once on the shared snapshot
+    std::vector<BfsState> states(queries);
+    std::vector<std::thread> threads;
+    for (int q = 0; q < queries; q++) {
+        threads.emplace_back([&csr, &states, q]() {
+            for (int round = 0; round < 5; round++) {
+                bfs(&csr, static_cast<uint32_t>(q * 100), states[q], round % 2 == 0 ? BfsTopDown : BfsDirectionOptimizing);
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    for (int q = 0; q < queries; q++) {
+        for (uint32_t id = 0; id < 2000; id++) {
+            QCOMPARE(states[q].getHops(id), expected[q].getHops(id));
+        }
+    }
+
+    // The vertex objects were never touched
+    for (BfsVertex<int> *vertex : vertices) {
+        QCOMPARE(vertex->getHops(), -1);
+        QCOMPARE(vertex->getColor(), white);
+    }
+}
+
+void TestCsrGraph::testReusedState()
+{
+    // Many short chains, so every search reaches only a few vertices
+    DfsGraph graph;
+    const int count = 1000;
+    std::vector<int> values(count);
+    std::vector<DfsVertex<int> *> vertices(count);
+
+    for (int i = 0; i < count; i++) {
+        values[i] = i;
+        vertices[i] = new DfsVertex<int>(&values[i]);
+        graph.insertVertex(vertices[i], true);
+    }
+    for (int i = 0; i + 1 < count; i++) {
+        if (i % 10 != 9) {
+            graph.insertEdge(vertices[i], vertices[i + 1]);
+        }
+    }
+
+    CsrGraph<DfsVertex<int>> csr(graph);
+    BfsState reused;
+    DfsState reusedDfs;
+
+    for (uint32_t source = 0; source < count; source += 7) {
+        BfsState fresh;
+        QCOMPARE(bfs(&csr, source, reused), 0);
+        QCOMPARE(bfs(&csr, source, fresh), 0);
+        QCOMPARE(reused.reached, fresh.reached);
+        QCOMPARE(static_cast<uint32_t>(reused.reached.size()), 10 - source % 10);
+
+        for (uint32_t id = 0; id < count; id++) {
+            QCOMPARE(reused.getHops(id), fresh.getHops(id));
+        }
+
+        // A single-root dfs leaves the rest of the graph white
+        QCOMPARE(dfs(&csr, source, reusedDfs), 0);
+        QCOMPARE(reusedDfs.finished.size(), reused.reached.size());
+        QCOMPARE(reusedDfs.finished.back(), source);
+        for (uint32_t id = 0; id < count; id++) {
+            QCOMPARE(reusedDfs.getColor(id), reused.getColor(id));
+        }
+    }
+
+    // Old marks are cleared when the epoch counter wraps around
+    reused.epoch = UINT32_MAX - 1;
+    QCOMPARE(bfs(&csr, 0u, reused), 0);
+    QCOMPARE(reused.epoch, UINT32_MAX);
+    QCOMPARE(bfs(&csr, 20u, reused), 0);
+    QCOMPARE(reused.epoch, 1u);
+    QCOMPARE(reused.getHops(0), -1);
+    QCOMPARE(reused.getHops(21), 1);
+
+    QCOMPARE(dfs(&csr, 1000u, reusedDfs), -1);
+}
+
+QTEST_APPLESS_MAIN(TestCsrGraph)
+#include "tst_csrgraph.moc"
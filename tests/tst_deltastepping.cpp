@@ -0,0 +1,299 @@
+#include <QtTest/QtTest>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+#include "../graph.h"
+#include "../csrgraph.h"
+#include "../dijkstra.h"
+#include "../deltastepping.h"
+#include "../threadpool.h"
+#include "randomgraph.h"
+
+class TestDeltaStepping : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Runs before each test function
+    void init();
+
+    // Runs after each test function
+    void cleanup();
+
+    // Test functions - each test is a separate function
+    void testSmallGraph();
+    void testMatchesDijkstra_data();
+    void testMatchesDijkstra();
+    void testGrid();
+    void testZeroWeights();
+    void testTinyDelta();
+    void testInvalidInput();
+    void testGraphOverload();
+};
+
+// Check that every reached vertex's parent edge accounts for its distance,
+// and that following parents from any vertex ends at the source
+static bool isShortestPathTree(const CsrGraph<int> &csr, const ShortestPathTree &tree, uint32_t source)
+{
+    uint32_t vertexCount = static_cast<uint32_t>(csr.getVertexCount());
+
+    for (uint32_t id = 0; id < vertexCount; id++) {
+        uint32_t parent = tree.getParent(id);
+        if (id == source || !tree.isReached(id)) {
+            if (parent != ShortestPathTree::noParent) {
+                return false;
+            }
+            continue;
+        }
+
+        const uint32_t *adj = std::find(csr.adjacentBegin(parent), csr.adjacentEnd(parent), id);
+        if (adj == csr.adjacentEnd(parent)) {
+            return false;
+        }
+        double weight = csr.weightsBegin(parent)[adj - csr.adjacentBegin(parent)];
+        if (tree.getDistance(parent) + weight != tree.getDistance(id)) {
+            return false;
+        }
+
+        uint32_t steps = 0;
+        for (uint32_t up = id; up != source; up = tree.getParent(up)) {
+            if (up == ShortestPathTree::noParent || ++steps > vertexCount) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void TestDeltaStepping::init()
+{
+    // Setup code that runs before each test
+}
+
+void TestDeltaStepping::cleanup()
+{
+    // Cleanup code that runs after each test
+}
+
+void TestDeltaStepping::testSmallGraph()
+{
+    IntGraph graph;
+    int values[6] = {0, 1, 2, 3, 4, 5};
+    for (int &value : values) {
+        graph.insertVertex(&value);
+    }
+
+    // The heavy direct edge 0 -> 3 loses to the light path 0 -> 1 -> 2 -> 3
+    graph.insertWeightedEdge(&values[0], &values[1], 1.0);
+    graph.insertWeightedEdge(&values[1], &values[2], 2.0);
+    graph.insertWeightedEdge(&values[2], &values[3], 0.5);
+    graph.insertWeightedEdge(&values[0], &values[3], 4.0);
+    graph.insertEdge(&values[3], &values[4]);
+    graph.insertWeightedEdge(&values[5], &values[0], 1.0);
+
+    CsrGraph<int> csr(graph);
+    ThreadPool pool(2);
+    ShortestPathTree tree;
+    QCOMPARE(deltaStepping(&csr, 0, 2.0, tree, pool), 0);
+
+    const double expected[5] = {0.0, 1.0, 3.0, 3.5, 4.5};
+    for (uint32_t id = 0; id < 5; id++) {
+        QCOMPARE(tree.getDistance(id), expected[id]);
+    }
+    QVERIFY(!tree.isReached(5));
+
+    std::vector<uint32_t> path;
+    QCOMPARE(tree.getPath(4, path), 0);
+    QVERIFY(path == std::vector<uint32_t>({0, 1, 2, 3, 4}));
+}
+
+void TestDeltaStepping::testMatchesDijkstra_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("edges");
+    QTest::addColumn<double>("delta");
+    QTest::addColumn<int>("threads");
+
+    // Deltas from far below the weights, where most edges are heavy, to
+    // above all of them, where every edge is light
+    QTest::newRow("tiny delta") << 2000 << 8000 << 0.5 << 2;
+    QTest::newRow("average delta") << 5000 << 20000 << 5.0 << 4;
+    QTest::newRow("huge delta") << 2000 << 8000 << 1000.0 << 3;
+    QTest::newRow("sparse") << 5000 << 6000 << 3.0 << 4;
+    QTest::newRow("single thread") << 3000 << 12000 << 2.0 << 1;
+}
+
+void TestDeltaStepping::testMatchesDijkstra()
+{
+    QFETCH(int, count);
+    QFETCH(int, edges);
+    QFETCH(double, delta);
+    QFETCH(int, threads);
+
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomGraph(graph, values, count, edges, 10.0, count + edges);
+    CsrGraph<int> csr(graph);
+
+    ShortestPathTree expected;
+    QCOMPARE(dijkstra(&csr, 0, expected), 0);
+
+    ThreadPool pool(threads);
+    ShortestPathTree tree;
+    QCOMPARE(deltaStepping(&csr, 0, delta, tree, pool), 0);
+    QVERIFY(tree.distances == expected.distances);
+    QVERIFY(isShortestPathTree(csr, tree, 0));
+
+    // The pool and the tree can be reused from another source
+    QCOMPARE(dijkstra(&csr, 7, expected), 0);
+    QCOMPARE(deltaStepping(&csr, 7, delta, tree, pool), 0);
+    QVERIFY(tree.distances == expected.distances);
+    QVERIFY(isShortestPathTree(csr, tree, 7));
+}
+
+void TestDeltaStepping::testGrid()
+{
+    // Long shortest paths across many buckets, from a corner of a grid
+    // with edges both ways
+    const int side = 128;
+    IntGraph graph;
+    std::vector<int> values(side * side);
+    for (int i = 0; i < side * side; i++) {
+        values[i] = i;
+        graph.insertVertex(&values[i]);
+    }
+
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<double> weigh(1.0, 10.0);
+    for (int i = 0; i < side * side; i++) {
+        if (i % side + 1 < side) {
+            graph.insertWeightedEdge(&values[i], &values[i + 1], weigh(rng));
+            graph.insertWeightedEdge(&values[i + 1], &values[i], weigh(rng));
+        }
+        if (i + side < side * side) {
+            graph.insertWeightedEdge(&values[i], &values[i + side], weigh(rng));
+            graph.insertWeightedEdge(&values[i + side], &values[i], weigh(rng));
+        }
+    }
+
+    CsrGraph<int> csr(graph);
+    ShortestPathTree expected;
+    QCOMPARE(dijkstra(&csr, 0, expected), 0);
+
+    ThreadPool pool(4);
+    ShortestPathTree tree;
+    for (double delta : {1.0, 5.5, 40.0}) {
+        QCOMPARE(deltaStepping(&csr, 0, delta, tree, pool), 0);
+        QVERIFY(tree.distances == expected.distances);
+        QVERIFY(isShortestPathTree(csr, tree, 0));
+    }
+}
+
+void TestDeltaStepping::testZeroWeights()
+{
+    // A zero-weight cycle between 1 and 2, the other edges unweighted
+    IntGraph graph;
+    int values[5] = {0, 1, 2, 3, 4};
+    for (int &value : values) {
+        graph.insertVertex(&value);
+    }
+    graph.insertEdge(&values[0], &values[1]);
+    graph.insertWeightedEdge(&values[1], &values[2], 0.0);
+    graph.insertWeightedEdge(&values[2], &values[1], 0.0);
+    graph.insertEdge(&values[2], &values[3]);
+    graph.insertEdge(&values[3], &values[4]);
+
+    CsrGraph<int> csr(graph);
+    ThreadPool pool(3);
+    ShortestPathTree tree;
+    QCOMPARE(deltaStepping(&csr, 0, 1.0, tree, pool), 0);
+
+    const double expected[5] = {0.0, 1.0, 1.0, 2.0, 3.0};
+    for (uint32_t id = 0; id < 5; id++) {
+        QCOMPARE(tree.getDistance(id), expected[id]);
+    }
+    QVERIFY(isShortestPathTree(csr, tree, 0));
+}
+
+void TestDeltaStepping::testTinyDelta()
+{
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomGraph(graph, values, 300, 1200, 10.0, 11);
+
+    // Unit weights on a path, so distance / delta would not fit a size_t
+    for (int i = 0; i + 1 < 300; i++) {
+        graph.insertEdge(&values[i], &values[i + 1]);
+    }
+    CsrGraph<int> csr(graph);
+
+    ShortestPathTree expected;
+    QCOMPARE(dijkstra(&csr, 0, expected), 0);
+
+    // Deltas far below the weights need no more buckets than a coarse one
+    ThreadPool pool(3);
+    ShortestPathTree tree;
+    for (double delta : {1e-3, 1e-9, 1e-300, std::numeric_limits<double>::denorm_min()}) {
+        QCOMPARE(deltaStepping(&csr, 0, delta, tree, pool), 0);
+        QVERIFY(tree.distances == expected.distances);
+        QVERIFY(isShortestPathTree(csr, tree, 0));
+    }
+
+    // An infinite delta makes every edge light
+    QCOMPARE(deltaStepping(&csr, 0, std::numeric_limits<double>::infinity(), tree, pool), 0);
+    QVERIFY(tree.distances == expected.distances);
+}
+
+void TestDeltaStepping::testInvalidInput()
+{
+    IntGraph graph;
+    int values[3] = {0, 1, 2};
+    for (int &value : values) {
+        graph.insertVertex(&value);
+    }
+    graph.insertWeightedEdge(&values[0], &values[1], 2.0);
+    graph.insertWeightedEdge(&values[2], &values[1], -1.0);
+
+    CsrGraph<int> csr(graph);
+    ThreadPool pool(2);
+    ShortestPathTree tree;
+
+    // Unlike dijkstra, the whole graph is checked for negative weights
+    QCOMPARE(deltaStepping(&csr, 0, 1.0, tree, pool), -1);
+
+    IntGraph positive;
+    positive.insertVertex(&values[0]);
+    CsrGraph<int> single(positive);
+    QCOMPARE(deltaStepping(&single, 0, 0.0, tree, pool), -1);
+    QCOMPARE(deltaStepping(&single, 0, -1.0, tree, pool), -1);
+    QCOMPARE(deltaStepping(&single, 0, std::numeric_limits<double>::quiet_NaN(), tree, pool), -1);
+    QCOMPARE(deltaStepping(&single, 1, 1.0, tree, pool), -1);
+    QCOMPARE(deltaStepping(static_cast<const CsrGraph<int> *>(nullptr), 0, 1.0, tree, pool), -1);
+
+    QCOMPARE(deltaStepping(&single, 0, 1.0, tree, pool), 0);
+    QCOMPARE(tree.getDistance(0), 0.0);
+}
+
+void TestDeltaStepping::testGraphOverload()
+{
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomGraph(graph, values, 400, 1600, 5.0, 3);
+    CsrGraph<int> csr(graph);
+
+    ShortestPathTree fromCsr;
+    ShortestPathTree fromGraph;
+    ThreadPool pool(2);
+    QCOMPARE(dijkstra(&csr, csr.idOf(&values[7]), fromCsr), 0);
+    QCOMPARE(deltaStepping(&graph, &values[7], 2.5, fromGraph, pool), 0);
+    QVERIFY(fromGraph.distances == fromCsr.distances);
+
+    int missing = 400;
+    QCOMPARE(deltaStepping(&graph, &missing, 2.5, fromGraph, pool), -1);
+    QCOMPARE(deltaStepping(static_cast<IntGraph *>(nullptr), &values[0], 2.5, fromGraph, pool), -1);
+}
+
+QTEST_APPLESS_MAIN(TestDeltaStepping)
+#include "tst_deltastepping.moc"
@@ -0,0 +1,336 @@
+#include <QtTest/QtTest>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+#include "../indexedheap.h"
+#include "../graph.h"
+#include "../csrgraph.h"
+#include "../dijkstra.h"
+#include "randomgraph.h"
+
+class TestDijkstra : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Runs before each test function
+    void init();
+
+    // Runs after each test function
+    void cleanup();
+
+    // Test functions - each test is a separate function
+    void testHeapOrder();
+    void testHeapDecreaseKey();
+    void testHeapReturnCodes();
+    void testSmallGraph();
+    void testMatchesBellmanFord_data();
+    void testMatchesBellmanFord();
+    void testUnweightedMatchesHops();
+    void testNegativeWeight();
+    void testGraphOverload();
+};
+
+// Distances by relaxing every edge until nothing changes
+static std::vector<double> bellmanFord(const CsrGraph<int> &csr, uint32_t source)
+{
+    uint32_t vertexCount = static_cast<uint32_t>(csr.getVertexCount());
+    std::vector<double> distances(vertexCount, std::numeric_limits<double>::infinity());
+    distances[source] = 0;
+
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (uint32_t id = 0; id < vertexCount; id++) {
+            const double *weight = csr.weightsBegin(id);
+            for (const uint32_t *adj = csr.adjacentBegin(id); adj != csr.adjacentEnd(id); adj++, weight++) {
+                if (distances[id] + *weight < distances[*adj]) {
+                    distances[*adj] = distances[id] + *weight;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    return distances;
+}
+
+// Check that every reached vertex's parent edge accounts for its distance
+static bool parentsMatchDistances(const CsrGraph<int> &csr, const ShortestPathTree &tree, uint32_t source)
+{
+    for (uint32_t id = 0; id < static_cast<uint32_t>(csr.getVertexCount()); id++) {
+        uint32_t parent = tree.getParent(id);
+        if (id == source || !tree.isReached(id)) {
+            if (parent != ShortestPathTree::noParent) {
+                return false;
+            }
+            continue;
+        }
+
+        const uint32_t *adj = std::find(csr.adjacentBegin(parent), csr.adjacentEnd(parent), id);
+        if (adj == csr.adjacentEnd(parent)) {
+            return false;
+        }
+        double weight = csr.weightsBegin(parent)[adj - csr.adjacentBegin(parent)];
+        if (tree.getDistance(parent) + weight != tree.getDistance(id)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void TestDijkstra::init()
+{
+    // Setup code that runs before each test
+}
+
+void TestDijkstra::cleanup()
+{
+    // Cleanup code that runs after each test
+}
+
+void TestDijkstra::testHeapOrder()
+{
+    // Pops come out sorted, for binary and wider heaps
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> weigh(0, 99);
+    std::vector<int> priorities(1000);
+    for (int &priority : priorities) {
+        priority = weigh(rng);
+    }
+
+    IndexedHeap<int, 2> binary(1000);
+    IndexedHeap<int, 8> wide(1000);
+    for (uint32_t index = 0; index < 1000; index++) {
+        QCOMPARE(binary.push(index, priorities[index]), 0);
+        QCOMPARE(wide.push(index, priorities[index]), 0);
+    }
+    QCOMPARE(binary.getSize(), 1000);
+
+    std::vector<int> sorted = priorities;
+    std::sort(sorted.begin(), sorted.end());
+
+    for (int expected : sorted) {
+        uint32_t index = UINT32_MAX;
+        int priority = INT_MAX;
+        QCOMPARE(binary.pop(&index, &priority), 0);
+        QCOMPARE(priority, expected);
+        QCOMPARE(priorities[index], expected);
+        QVERIFY(!binary.contains(index));
+
+        QCOMPARE(wide.topPriority(), expected);
+        QCOMPARE(wide.pop(&index), 0);
+        QCOMPARE(priorities[index], expected);
+    }
+    QVERIFY(binary.isEmpty());
+    QVERIFY(wide.isEmpty());
+}
+
+void TestDijkstra::testHeapDecreaseKey()
+{
+    IndexedHeap<double> heap(6);
+    for (uint32_t index = 0; index < 6; index++) {
+        heap.push(index, 10.0 + index);
+    }
+    QCOMPARE(heap.top(), 0u);
+
+    QCOMPARE(heap.decreaseKey(5, 1.5), 0);
+    QCOMPARE(heap.top(), 5u);
+    QCOMPARE(heap.getPriority(5), 1.5);
+
+    QCOMPARE(heap.decreaseKey(3, 2.5), 0);
+    QCOMPARE(heap.decreaseKey(3, 9.0), 1);  // Not lower
+    QCOMPARE(heap.getPriority(3), 2.5);
+
+    const uint32_t expected[6] = {5, 3, 0, 1, 2, 4};
+    for (uint32_t index : expected) {
+        uint32_t popped = UINT32_MAX;
+        QCOMPARE(heap.pop(&popped), 0);
+        QCOMPARE(popped, index);
+    }
+
+    // A popped index can be pushed again
+    QCOMPARE(heap.push(3, 7.0), 0);
+    QCOMPARE(heap.top(), 3u);
+}
+
+void TestDijkstra::testHeapReturnCodes()
+{
+    IndexedHeap<double> heap(3);
+    QCOMPARE(heap.getCapacity(), 3u);
+    QCOMPARE(heap.pop(nullptr), -1);
+
+    QCOMPARE(heap.push(1, 4.0), 0);
+    QCOMPARE(heap.push(1, 2.0), 1);  // Already in, priority kept
+    QCOMPARE(heap.getPriority(1), 4.0);
+    QCOMPARE(heap.push(3, 1.0), -1);
+
+    QCOMPARE(heap.decreaseKey(0, 1.0), -1);
+    QCOMPARE(heap.decreaseKey(9, 1.0), -1);
+
+    heap.reset(10);
+    QVERIFY(heap.isEmpty());
+    QVERIFY(!heap.contains(1));
+    QCOMPARE(heap.push(9, 1.0), 0);
+}
+
+void TestDijkstra::testSmallGraph()
+{
+    IntGraph graph;
+    int values[6] = {0, 1, 2, 3, 4, 5};
+    for (int &value : values) {
+        graph.insertVertex(&value);
+    }
+
+    // The direct edge 0 -> 3 is longer than 0 -> 1 -> 2 -> 3; 5 is unreachable
+    graph.insertWeightedEdge(&values[0], &values[1], 1.0);
+    graph.insertWeightedEdge(&values[1], &values[2], 2.0);
+    graph.insertWeightedEdge(&values[2], &values[3], 0.5);
+    graph.insertWeightedEdge(&values[0], &values[3], 4.0);
+    graph.insertEdge(&values[3], &values[4]);
+    graph.insertWeightedEdge(&values[5], &values[0], 1.0);
+
+    CsrGraph<int> csr(graph);
+    ShortestPathTree tree;
+    QCOMPARE(dijkstra(&csr, 0, tree), 0);
+
+    const double expected[5] = {0.0, 1.0, 3.0, 3.5, 4.5};
+    for (uint32_t id = 0; id < 5; id++) {
+        QVERIFY(tree.isReached(id));
+        QCOMPARE(tree.getDistance(id), expected[id]);
+    }
+    QVERIFY(!tree.isReached(5));
+    QCOMPARE(tree.getParent(5), ShortestPathTree::noParent);
+    QCOMPARE(tree.getParent(0), ShortestPathTree::noParent);
+
+    std::vector<uint32_t> path;
+    QCOMPARE(tree.getPath(4, path), 0);
+    QVERIFY(path == std::vector<uint32_t>({0, 1, 2, 3, 4}));
+    QCOMPARE(tree.getPath(5, path), 1);
+    QVERIFY(path.empty());
+
+    QCOMPARE(dijkstra(&csr, 6, tree), -1);
+    QCOMPARE(dijkstra(static_cast<const CsrGraph<int> *>(nullptr), 0, tree), -1);
+}
+
+void TestDijkstra::testMatchesBellmanFord_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("edges");
+    QTest::addColumn<double>("maxWeight");
+
+    QTest::newRow("sparse") << 2000 << 3000 << 10.0;
+    QTest::newRow("dense") << 500 << 10000 << 100.0;
+    QTest::newRow("light") << 1000 << 5000 << 0.01;
+}
+
+void TestDijkstra::testMatchesBellmanFord()
+{
+    QFETCH(int, count);
+    QFETCH(int, edges);
+    QFETCH(double, maxWeight);
+
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomGraph(graph, values, count, edges, maxWeight, count + edges);
+    CsrGraph<int> csr(graph);
+    std::vector<double> expected = bellmanFord(csr, 0);
+
+    ShortestPathTree binary;
+    ShortestPathTree quaternary;
+    ShortestPathTree octonary;
+    QCOMPARE(dijkstra<2>(&csr, 0, binary), 0);
+    QCOMPARE(dijkstra(&csr, 0, quaternary), 0);
+    QCOMPARE(dijkstra<8>(&csr, 0, octonary), 0);
+
+    for (int id = 0; id < count; id++) {
+        QCOMPARE(binary.getDistance(id), expected[id]);
+    }
+    QVERIFY(quaternary.distances == binary.distances);
+    QVERIFY(octonary.distances == binary.distances);
+    QVERIFY(parentsMatchDistances(csr, binary, 0));
+    QVERIFY(parentsMatchDistances(csr, quaternary, 0));
+}
+
+void TestDijkstra::testUnweightedMatchesHops()
+{
+    // Without weights every edge weighs 1, so distances are BFS hop counts
+    IntGraph graph;
+    std::vector<int> values(3000);
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> pick(0, 2999);
+    for (int i = 0; i < 3000; i++) {
+        values[i] = i;
+        graph.insertVertex(&values[i]);
+    }
+    for (int i = 0; i < 6000; i++) {
+        graph.insertEdge(&values[pick(rng)], &values[pick(rng)]);
+    }
+
+    CsrGraph<int> csr(graph);
+    std::vector<int> hops(3000, -1);
+    std::vector<uint32_t> frontier(1, 0);
+    hops[0] = 0;
+    for (size_t next = 0; next < frontier.size(); next++) {
+        uint32_t id = frontier[next];
+        for (const uint32_t *adj = csr.adjacentBegin(id); adj != csr.adjacentEnd(id); adj++) {
+            if (hops[*adj] < 0) {
+                hops[*adj] = hops[id] + 1;
+                frontier.push_back(*adj);
+            }
+        }
+    }
+
+    ShortestPathTree tree;
+    QCOMPARE(dijkstra(&csr, 0, tree), 0);
+    for (uint32_t id = 0; id < 3000; id++) {
+        if (hops[id] < 0) {
+            QVERIFY(!tree.isReached(id));
+        } else {
+            QCOMPARE(tree.getDistance(id), double(hops[id]));
+        }
+    }
+}
+
+void TestDijkstra::testNegativeWeight()
+{
+    IntGraph graph;
+    int values[3] = {0, 1, 2};
+    for (int &value : values) {
+        graph.insertVertex(&value);
+    }
+    graph.insertWeightedEdge(&values[0], &values[1], 2.0);
+    graph.insertWeightedEdge(&values[1], &values[2], -1.0);
+
+    CsrGraph<int> csr(graph);
+    ShortestPathTree tree;
+    QCOMPARE(dijkstra(&csr, 0, tree), -1);
+
+    // Not reached from 2, so the search does not see it
+    QCOMPARE(dijkstra(&csr, 2, tree), 0);
+}
+
+void TestDijkstra::testGraphOverload()
+{
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomGraph(graph, values, 400, 1600, 5.0, 3);
+    CsrGraph<int> csr(graph);
+
+    ShortestPathTree fromCsr;
+    ShortestPathTree fromGraph;
+    QCOMPARE(dijkstra(&csr, csr.idOf(&values[7]), fromCsr), 0);
+    QCOMPARE(dijkstra(&graph, &values[7], fromGraph), 0);
+    QVERIFY(fromGraph.distances == fromCsr.distances);
+    QVERIFY(fromGraph.parents == fromCsr.parents);
+
+    int missing = 400;
+    QCOMPARE(dijkstra(&graph, &missing, fromGraph), -1);
+    QCOMPARE(dijkstra(static_cast<IntGraph *>(nullptr), &values[0], fromGraph), -1);
+}
+
+QTEST_APPLESS_MAIN(TestDijkstra)
+#include "tst_dijkstra.moc"
@@ -0,0 +1,237 @@
+#include <QtTest/QtTest>
+#include <vector>
+#include "../disjointset.h"
+#include "../graph.h"
+#include "../csrgraph.h"
+#include "../connectedcomponents.h"
+#include "../threadpool.h"
+#include "randomgraph.h"
+
+class TestDisjointSet : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Runs before each test function
+    void init();
+
+    // Runs after each test function
+    void cleanup();
+
+    // Test functions - each test is a separate function
+    void testUnite();
+    void testReset();
+    void testLongChains();
+    void testComponents();
+    void testMatchesSearch_data();
+    void testMatchesSearch();
+    void testGraphOverload();
+};
+
+// Components found by searching along edges both ways from each unlabelled
+// vertex, numbered in order of their lowest vertex ID
+static std::vector<uint32_t> searchComponents(const CsrGraph<int> &csr)
+{
+    uint32_t vertexCount = static_cast<uint32_t>(csr.getVertexCount());
+    std::vector<uint32_t> component(vertexCount, CsrGraph<int>::noVertex);
+    std::vector<uint32_t> stack;
+    uint32_t count = 0;
+
+    for (uint32_t root = 0; root < vertexCount; root++) {
+        if (component[root] != CsrGraph<int>::noVertex) {
+            continue;
+        }
+
+        component[root] = count;
+        stack.push_back(root);
+        while (!stack.empty()) {
+            uint32_t vertex = stack.back();
+            stack.pop_back();
+
+            std::vector<uint32_t> neighbours(csr.adjacentBegin(vertex), csr.adjacentEnd(vertex));
+            neighbours.insert(neighbours.end(), csr.incomingBegin(vertex), csr.incomingEnd(vertex));
+            for (uint32_t next : neighbours) {
+                if (component[next] == CsrGraph<int>::noVertex) {
+                    component[next] = count;
+                    stack.push_back(next);
+                }
+            }
+        }
+        count++;
+    }
+
+    return component;
+}
+
+void TestDisjointSet::init()
+{
+    // Setup code that runs before each test
+}
+
+void TestDisjointSet::cleanup()
+{
+    // Cleanup code that runs after each test
+}
+
+void TestDisjointSet::testUnite()
+{
+    DisjointSet sets(6);
+    QCOMPARE(sets.getSize(), 6u);
+    QCOMPARE(sets.getSetCount(), 6u);
+    QVERIFY(!sets.isSameSet(0, 1));
+
+    QCOMPARE(sets.unite(0, 1), 0);
+    QCOMPARE(sets.unite(2, 3), 0);
+    QCOMPARE(sets.unite(1, 3), 0);
+    QCOMPARE(sets.getSetCount(), 3u);
+
+    QVERIFY(sets.isSameSet(0, 2));
+    QVERIFY(sets.isSameSet(3, 0));
+    QVERIFY(!sets.isSameSet(0, 4));
+    QCOMPARE(sets.find(0), sets.find(3));
+
+    // Already together, or out of range
+    QCOMPARE(sets.unite(2, 0), 1);
+    QCOMPARE(sets.unite(4, 4), 1);
+    QCOMPARE(sets.unite(5, 6), -1);
+    QCOMPARE(sets.getSetCount(), 3u);
+}
+
+void TestDisjointSet::testReset()
+{
+    DisjointSet sets;
+    QCOMPARE(sets.getSize(), 0u);
+    QCOMPARE(sets.getSetCount(), 0u);
+
+    sets.reset(4);
+    QCOMPARE(sets.unite(0, 3), 0);
+    QCOMPARE(sets.getSetCount(), 3u);
+
+    sets.reset(8);
+    QCOMPARE(sets.getSize(), 8u);
+    QCOMPARE(sets.getSetCount(), 8u);
+    QVERIFY(!sets.isSameSet(0, 3));
+    for (uint32_t element = 0; element < 8; element++) {
+        QCOMPARE(sets.find(element), element);
+    }
+}
+
+void TestDisjointSet::testLongChains()
+{
+    // Uniting along a line in both directions stays one set with shallow finds
+    const uint32_t count = 1 << 20;
+    DisjointSet sets(count);
+    for (uint32_t element = 1; element < count / 2; element++) {
+        QCOMPARE(sets.unite(element - 1, element), 0);
+    }
+    for (uint32_t element = count - 1; element > count / 2; element--) {
+        QCOMPARE(sets.unite(element, element - 1), 0);
+    }
+    QCOMPARE(sets.getSetCount(), 2u);
+
+    QCOMPARE(sets.unite(0, count - 1), 0);
+    QCOMPARE(sets.getSetCount(), 1u);
+
+    uint32_t root = sets.find(count / 2);
+    for (uint32_t element = 0; element < count; element += 4099) {
+        QCOMPARE(sets.find(element), root);
+    }
+}
+
+void TestDisjointSet::testComponents()
+{
+    IntGraph graph;
+    int values[7] = {0, 1, 2, 3, 4, 5, 6};
+    for (int &value : values) {
+        graph.insertVertex(&value);
+    }
+
+    // 0 -> 1 <- 2, 3 -> 4 -> 3, 5 -> 5, 6 alone; 4 -> 6 joins 6 to {3, 4}
+    graph.insertEdge(&values[0], &values[1]);
+    graph.insertEdge(&values[2], &values[1]);
+    graph.insertEdge(&values[3], &values[4]);
+    graph.insertEdge(&values[4], &values[3]);
+    graph.insertEdge(&values[5], &values[5]);
+    graph.insertEdge(&values[4], &values[6]);
+
+    CsrGraph<int> csr(graph);
+    ThreadPool pool(2);
+    Components sequential;
+    Components parallel;
+    QCOMPARE(connectedComponents(&csr, sequential), 0);
+    QCOMPARE(parallelConnectedComponents(&csr, parallel, pool), 0);
+
+    const uint32_t expected[7] = {0, 0, 0, 1, 1, 2, 1};
+    for (Components *components : {&sequential, &parallel}) {
+        QCOMPARE(components->getComponentCount(), 3u);
+        for (uint32_t id = 0; id < 7; id++) {
+            QCOMPARE(components->getComponent(id), expected[id]);
+        }
+    }
+
+    IntGraph empty;
+    CsrGraph<int> emptyCsr(empty);
+    QCOMPARE(parallelConnectedComponents(&emptyCsr, parallel, pool), 0);
+    QCOMPARE(parallel.getComponentCount(), 0u);
+    QCOMPARE(connectedComponents(static_cast<const CsrGraph<int> *>(nullptr), sequential), -1);
+}
+
+void TestDisjointSet::testMatchesSearch_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("edges");
+    QTest::addColumn<int>("threads");
+
+    // Many small components, around the giant component threshold, one giant
+    QTest::newRow("fragments") << 5000 << 1500 << 2;
+    QTest::newRow("threshold") << 5000 << 2500 << 3;
+    QTest::newRow("giant") << 20000 << 40000 << 4;
+    QTest::newRow("single thread") << 3000 << 2000 << 1;
+}
+
+void TestDisjointSet::testMatchesSearch()
+{
+    QFETCH(int, count);
+    QFETCH(int, edges);
+    QFETCH(int, threads);
+
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomGraph(graph, values, count, edges, count + edges);
+    CsrGraph<int> csr(graph);
+    std::vector<uint32_t> expected = searchComponents(csr);
+
+    Components sequential;
+    QCOMPARE(connectedComponents(&csr, sequential), 0);
+    QVERIFY(sequential.component == expected);
+    QCOMPARE(sequential.getComponentCount(), *std::max_element(expected.begin(), expected.end()) + 1);
+
+    ThreadPool pool(threads);
+    Components parallel;
+    QCOMPARE(parallelConnectedComponents(&csr, parallel, pool), 0);
+    QVERIFY(parallel.component == expected);
+    QCOMPARE(parallel.getComponentCount(), sequential.getComponentCount());
+}
+
+void TestDisjointSet::testGraphOverload()
+{
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomGraph(graph, values, 400, 300, 9);
+    CsrGraph<int> csr(graph);
+
+    Components fromCsr;
+    Components fromGraph;
+    QCOMPARE(connectedComponents(&csr, fromCsr), 0);
+    QCOMPARE(connectedComponents(&graph, fromGraph), 0);
+    QVERIFY(fromGraph.component == fromCsr.component);
+
+    ThreadPool pool(2);
+    QCOMPARE(parallelConnectedComponents(&graph, fromGraph, pool), 0);
+    QVERIFY(fromGraph.component == fromCsr.component);
+
+    QCOMPARE(connectedComponents(static_cast<IntGraph *>(nullptr), fromGraph), -1);
+}
+
+QTEST_APPLESS_MAIN(TestDisjointSet)
+#include "tst_disjointset.moc"
@@ -0,0 +1,446 @@
+#include <QtTest/QtTest>
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <vector>
+#include "../flatset.h"
+#include "../graph.h"
+#include "../bfs.h"
+#include "../dfs.h"
+#include "../bfsvertex.h"
+#include "../dfsvertex.h"
+
+class TestFlatSet : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Runs before each test function
+    void init();
+
+    // Runs after each test function
+    void cleanup();
+
+    // Test functions - each test is a separate function
+    void testInsertKeepsOrder();
+    void testRemove();
+    void testIsMember();
+    void testOwnership();
+    void testUnion();
+    void testIntersection();
+    void testDifference();
+    void testGallopingOperations();
+    void testSubsetAndEqual();
+    void testCustomLess();
+    void testGraphAdjacency();
+};
+
+// Orders strings ignoring case, so "Apple" and "apple" are the same member
+struct LessCaseInsensitive
+{
+    bool operator()(const std::string &a, const std::string &b) const
+    {
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(),
+                                            [](char x, char y) { return std::tolower(x) < std::tolower(y); });
+    }
+};
+
+// Vertex functors for graphs with sorted adjacency
+struct CompareVertex
+{
+    bool operator()(const BfsVertex<int> &v1, const BfsVertex<int> &v2) const
+    {
+        return *v1.data == *v2.data;
+    }
+};
+
+struct LessVertex
+{
+    bool operator()(const BfsVertex<int> &v1, const BfsVertex<int> &v2) const
+    {
+        return *v1.data < *v2.data;
+    }
+};
+
+struct CompareDfsVertex
+{
+    bool operator()(const DfsVertex<int> &v1, const DfsVertex<int> &v2) const
+    {
+        return *v1.data == *v2.data;
+    }
+};
+
+struct LessDfsVertex
+{
+    bool operator()(const DfsVertex<int> &v1, const DfsVertex<int> &v2) const
+    {
+        return *v1.data < *v2.data;
+    }
+};
+
+// Collect the members of a set in iteration order
+template<class S> static std::vector<int> members(const S &set)
+{
+    std::vector<int> values;
+    for (auto node = set.head(); node != nullptr; node = node->next()) {
+        values.push_back(*node->data());
+    }
+    return values;
+}
+
+void TestFlatSet::init()
+{
+    // Setup code that runs before each test
+}
+
+void TestFlatSet::cleanup()
+{
+    // Cleanup code that runs after each test
+}
+
+void TestFlatSet::testInsertKeepsOrder()
+{
+    FlatSet<int> set;
+    int values[] = {5, 1, 4, 2, 3};
+
+    QVERIFY(set.head() == nullptr);
+    QVERIFY(set.tail() == nullptr);
+
+    for (int &value : values) {
+        set.insert(&value);
+    }
+
+    // Members are iterated in sorted order whatever the insertion order
+    QCOMPARE(set.getSize(), 5);
+    QCOMPARE(members(set), std::vector<int>({1, 2, 3, 4, 5}));
+    QCOMPARE(*set.head()->data(), 1);
+    QCOMPARE(*set.tail()->data(), 5);
+    QVERIFY(set.tail()->next() == nullptr);
+
+    // An equal value is a duplicate even if it is a different object
+    int duplicate = 3;
+    set.insert(&duplicate);
+    QCOMPARE(set.getSize(), 5);
+
+    // Null elements cannot be ordered and are ignored
+    set.insert(nullptr);
+    QCOMPARE(set.getSize(), 5);
+}
+
+void TestFlatSet::testRemove()
+{
+    FlatSet<int> set;
+    int values[] = {1, 2, 3, 4, 5};
+
+    for (int &value : values) {
+        set.insert(&value);
+    }
+
+    // Remove by value, from the middle, the front and the back
+    int three = 3;
+    QVERIFY(set.remove(&three));
+    QVERIFY(set.remove(&values[0]));
+    QVERIFY(set.remove(&values[4]));
+    QCOMPARE(members(set), std::vector<int>({2, 4}));
+
+    // Removing a missing element fails
+    int missing = 6;
+    QVERIFY(!set.remove(&missing));
+    QVERIFY(!set.remove(&three));
+    QVERIFY(!set.remove(nullptr));
+    QCOMPARE(set.getSize(), 2);
+
+    QVERIFY(set.remove(&values[1]));
+    QVERIFY(set.remove(&values[3]));
+    QCOMPARE(set.getSize(), 0);
+    QVERIFY(set.head() == nullptr);
+}
+
+void TestFlatSet::testIsMember()
+{
+    FlatSet<int> set;
+    std::vector<int> values(1000);
+
+    // Insert the even numbers
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int>(i) * 2;
+        set.insert(&values[i]);
+    }
+
+    for (int i = -1; i <= 2000; i++) {
+        QCOMPARE(set.isMember(&i), i >= 0 && i < 2000 && i % 2 == 0);
+    }
+    QVERIFY(!set.isMember(nullptr));
+}
+
+void TestFlatSet::testOwnership()
+{
+    FlatSet<int> set;
+    int *owned = new int(1);
+    int *notOwned = new int(2);
+
+    set.insert(owned, true);
+    set.insert(notOwned, false);
+
+    QVERIFY(set.hasOwnership(owned));
+    QVERIFY(!set.hasOwnership(notOwned));
+
+    // Removing releases ownership, so the caller deletes the element
+    QVERIFY(set.remove(owned));
+    QVERIFY(!set.hasOwnership(owned));
+    delete owned;
+
+    // Owned elements still in the set are deleted with it
+    {
+        FlatSet<int> ownerSet;
+        ownerSet.insert(new int(3), true);
+        ownerSet.insert(new int(4), true);
+        QCOMPARE(ownerSet.getSize(), 2);
+    }
+
+    delete notOwned;
+}
+
+void TestFlatSet::testUnion()
+{
+    FlatSet<int> set1;
+    FlatSet<int> set2;
+    FlatSet<int> result;
+    int values[] = {1, 2, 3, 4, 5, 6};
+
+    // set1 = {1, 3, 5, 6}, set2 = {2, 3, 4, 6}
+    set1.insert(&values[0]);
+    set1.insert(&values[2]);
+    set1.insert(&values[4]);
+    set1.insert(&values[5]);
+    set2.insert(&values[1]);
+    set2.insert(&values[2]);
+    set2.insert(&values[3]);
+    set2.insert(&values[5]);
+
+    FlatSet<int>::unionSet(&result, &set1, &set2);
+    QCOMPARE(members(result), std::vector<int>({1, 2, 3, 4, 5, 6}));
+
+    // Union into a non-empty result keeps its members
+    FlatSet<int> extra;
+    int seven = 7;
+    extra.insert(&seven);
+    extra.insert(&values[0]);
+    FlatSet<int>::unionSet(&extra, &set2, &set2);
+    QCOMPARE(members(extra), std::vector<int>({1, 2, 3, 4, 6, 7}));
+
+    // Union with an empty set is a copy
+    FlatSet<int> empty;
+    FlatSet<int> copy;
+    FlatSet<int>::unionSet(&copy, &set1, &empty);
+    QVERIFY(FlatSet<int>::isEqualSet(&copy, &set1));
+}
+
+void TestFlatSet::testIntersection()
+{
+    FlatSet<int> set1;
+    FlatSet<int> set2;
+    FlatSet<int> result;
+    int values[] = {1, 2, 3, 4, 5, 6};
+
+    // set1 = {1, 3, 5, 6}, set2 = {2, 3, 4, 6}
+    set1.insert(&values[0]);
+    set1.insert(&values[2]);
+    set1.insert(&values[4]);
+    set1.insert(&values[5]);
+    set2.insert(&values[1]);
+    set2.insert(&values[2]);
+    set2.insert(&values[3]);
+    set2.insert(&values[5]);
+
+    FlatSet<int>::intersectionSet(&result, &set1, &set2);
+    QCOMPARE(members(result), std::vector<int>({3, 6}));
+
+    // Disjoint sets have an empty intersection
+    FlatSet<int> odd;
+    FlatSet<int> even;
+    FlatSet<int> none;
+    odd.insert(&values[0]);
+    even.insert(&values[1]);
+    FlatSet<int>::intersectionSet(&none, &odd, &even);
+    QCOMPARE(none.getSize(), 0);
+}
+
+void TestFlatSet::testDifference()
+{
+    FlatSet<int> set1;
+    FlatSet<int> set2;
+    FlatSet<int> result;
+    int values[] = {1, 2, 3, 4, 5, 6};
+
+    // set1 = {1, 3, 5, 6}, set2 = {2, 3, 4, 6}
+    set1.insert(&values[0]);
+    set1.insert(&values[2]);
+    set1.insert(&values[4]);
+    set1.insert(&values[5]);
+    set2.insert(&values[1]);
+    set2.insert(&values[2]);
+    set2.insert(&values[3]);
+    set2.insert(&values[5]);
+
+    FlatSet<int>::differenceSet(&result, &set1, &set2);
+    QCOMPARE(members(result), std::vector<int>({1, 5}));
+
+    FlatSet<int> reverse;
+    FlatSet<int>::differenceSet(&reverse, &set2, &set1);
+    QCOMPARE(members(reverse), std::vector<int>({2, 4}));
+}
+
+void TestFlatSet::testGallopingOperations()
+{
+    // A small set against a much larger one takes the galloping path
+    FlatSet<int> small;
+    FlatSet<int> large;
+    std::vector<int> values(10000);
+    int probes[] = {-5, 0, 17, 4998, 5001, 9999, 20000};
+
+    // large holds the even numbers [0, 20000)
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int>(i) * 2;
+        large.insert(&values[i]);
+    }
+    for (int &probe : probes) {
+        small.insert(&probe);
+    }
+
+    FlatSet<int> common;
+    FlatSet<int>::intersectionSet(&common, &small, &large);
+    QCOMPARE(members(common), std::vector<int>({0, 4998}));
+
+    FlatSet<int> onlySmall;
+    FlatSet<int>::differenceSet(&onlySmall, &small, &large);
+    QCOMPARE(members(onlySmall), std::vector<int>({-5, 17, 5001, 9999, 20000}));
+
+    QVERIFY(!FlatSet<int>::isSubset(&small, &large));
+    QVERIFY(FlatSet<int>::isSubset(&common, &large));
+
+    // The galloping and merging paths agree on every member of large
+    FlatSet<int> half;
+    for (size_t i = 0; i < values.size(); i += 2) {
+        half.insert(&values[i]);
+    }
+    FlatSet<int> merged;
+    FlatSet<int>::intersectionSet(&merged, &half, &large);
+    QVERIFY(FlatSet<int>::isEqualSet(&merged, &half));
+}
+
+void TestFlatSet::testSubsetAndEqual()
+{
+    FlatSet<int> set1;
+    FlatSet<int> set2;
+    int values[] = {1, 2, 3};
+    int copies[] = {1, 2, 3};
+
+    set1.insert(&values[0]);
+    set1.insert(&values[1]);
+    set2.insert(&values[2]);
+    set2.insert(&values[1]);
+    set2.insert(&values[0]);
+
+    QVERIFY(FlatSet<int>::isSubset(&set1, &set2));
+    QVERIFY(!FlatSet<int>::isSubset(&set2, &set1));
+    QVERIFY(!FlatSet<int>::isEqualSet(&set1, &set2));
+
+    // Equality is by value, not by pointer
+    FlatSet<int> set3;
+    set3.insert(&copies[1]);
+    set3.insert(&copies[0]);
+    set3.insert(&copies[2]);
+    QVERIFY(FlatSet<int>::isEqualSet(&set2, &set3));
+    QVERIFY(FlatSet<int>::isSubset(&set3, &set2));
+
+    // The empty set is a subset of every set
+    FlatSet<int> empty;
+    QVERIFY(FlatSet<int>::isSubset(&empty, &set1));
+}
+
+void TestFlatSet::testCustomLess()
+{
+    FlatSet<std::string, LessCaseInsensitive> set;
+    std::string banana("banana");
+    std::string apple("Apple");
+    std::string cherry("cherry");
+    std::string lowerApple("apple");
+
+    set.insert(&banana);
+    set.insert(&apple);
+    set.insert(&cherry);
+
+    // Equivalent under the ordering means the same member
+    set.insert(&lowerApple);
+    QCOMPARE(set.getSize(), 3);
+    QVERIFY(set.isMember(&lowerApple));
+    QCOMPARE(set.head()->data(), &apple);
+    QCOMPARE(set.tail()->data(), &cherry);
+}
+
+void TestFlatSet::testGraphAdjacency()
+{
+    typedef FlatSet<BfsVertex<int>, LessVertex> SortedNeighbours;
+    Graph<BfsVertex<int>, CompareVertex, NoHash<BfsVertex<int>>, SortedNeighbours> graph;
+    const int count = 6;
+    int values[count];
+    BfsVertex<int> *vertices[count];
+
+    for (int i = 0; i < count; i++) {
+        values[i] = i;
+        vertices[i] = new BfsVertex<int>(&values[i]);
+        QCOMPARE(graph.insertVertex(vertices[i], true), 0);
+    }
+
+    // Insert the edges of vertex 0 out of order
+    QCOMPARE(graph.insertEdge(vertices[0], vertices[4]), 0);
+    QCOMPARE(graph.insertEdge(vertices[0], vertices[1]), 0);
+    QCOMPARE(graph.insertEdge(vertices[0], vertices[3]), 0);
+    QCOMPARE(graph.insertEdge(vertices[3], vertices[5]), 0);
+    QCOMPARE(graph.insertEdge(vertices[1], vertices[2]), 0);
+    QCOMPARE(graph.getEdgeCount(), 5);
+
+    // Neighbours are kept sorted
+    AdjacentList<BfsVertex<int>, CompareVertex, NoHash<BfsVertex<int>>, SortedNeighbours> *adjList = nullptr;
+    QCOMPARE(graph.buildAdjacentList(vertices[0], &adjList), 0);
+    std::vector<int> neighbours;
+    for (auto member = adjList->adjacent.head(); member != nullptr; member = member->next()) {
+        neighbours.push_back(*member->data()->data);
+    }
+    QCOMPARE(neighbours, std::vector<int>({1, 3, 4}));
+
+    QVERIFY(graph.isAdjacentGraph(vertices[0], vertices[3]));
+    QVERIFY(!graph.isAdjacentGraph(vertices[3], vertices[0]));
+
+    BfsVertex<int> *target = vertices[4];
+    QCOMPARE(graph.removeEdge(vertices[0], &target), 0);
+    QVERIFY(!graph.isAdjacentGraph(vertices[0], vertices[4]));
+
+    // BFS runs over the sorted neighbour sets
+    List<BfsVertex<int>> hops;
+    QCOMPARE(bfs(&graph, vertices[0], hops), 0);
+    QCOMPARE(vertices[2]->getHops(), 2);
+    QCOMPARE(vertices[5]->getHops(), 2);
+    QCOMPARE(vertices[4]->getHops(), -1);
+
+    // DFS too
+    Graph<DfsVertex<int>, CompareDfsVertex, NoHash<DfsVertex<int>>,
+          FlatSet<DfsVertex<int>, LessDfsVertex>> dfsGraph;
+    DfsVertex<int> *dfsVertices[count];
+    for (int i = 0; i < count; i++) {
+        dfsVertices[i] = new DfsVertex<int>(&values[i]);
+        dfsGraph.insertVertex(dfsVertices[i], true);
+    }
+    for (int i = 0; i + 1 < count; i++) {
+        dfsGraph.insertEdge(dfsVertices[i], dfsVertices[i + 1]);
+    }
+
+    List<DfsVertex<int>, CompareDfsVertex> ordered;
+    QCOMPARE(dfs(&dfsGraph, ordered), 0);
+    QCOMPARE(ordered.getSize(), count);
+    QCOMPARE(*ordered.head()->data()->data, 0);
+}
+
+QTEST_APPLESS_MAIN(TestFlatSet)
+#include "tst_flatset.moc"
@@ -1,5 +1,6 @@
 #include <QtTest/QtTest>
 #include <string>
+#include <vector>
 #include "../list.h"
 #include "../graph.h"
 #include "../bfs.h"
@@ -26,6 +27,10 @@ private slots:
     void testOwnership();
     void testBFS();
     void testDFS();
+    void testHashedVertexIndex();
+    void testRemoveVertexCascade();
+    void testDFSLongChain();
+    void testEdgeWeights();
 };
 
 // Simple test data class
@@ -57,6 +62,15 @@ struct CompareTestData
     }
 };
 
+struct HashTestData
+{
+    size_t operator()(const BfsVertex<TestData> &key) const
+    {
+        // Must agree with CompareTestData: equal values give equal hashes
+        return key.data == nullptr ? 0 : std::hash<int>()(key.data->value);
+    }
+};
+
 struct CompareTestString
 {
     bool operator()(const BfsVertex<std::string> &key1, const BfsVertex<std::string> &key2) const
@@ -346,6 +360,22 @@ void TestGraph::testBFS()
     QCOMPARE(hopCounts[4], 2); // E is 2 hops from A (via D)
 }
 
+struct CompareDfsInt
+{
+    bool operator()(const DfsVertex<int> &key1, const DfsVertex<int> &key2) const
+    {
+        return *key1.data == *key2.data;
+    }
+};
+
+struct HashDfsInt
+{
+    size_t operator()(const DfsVertex<int> &key) const
+    {
+        return std::hash<int>()(*key.data);
+    }
+};
+
 void TestGraph::testDFS()
 {
     // Create a graph for DFS testing
@@ -488,5 +518,233 @@ void TestGraph::testDFS()
     // CS150 doesn't have dependencies, so no constraints to check
 }
 
+void TestGraph::testHashedVertexIndex()
+{
+    Graph<BfsVertex<TestData>, CompareTestData, HashTestData> graph;
+    const int count = 200;
+    BfsVertex<TestData> *vertices[count];
+
+    for (int i = 0; i < count; i++) {
+        vertices[i] = new BfsVertex<TestData>(new TestData(i));
+        QCOMPARE(graph.insertVertex(vertices[i], true), 0);
+    }
+
+    // Duplicates are found through the index by value, not by pointer
+    BfsVertex<TestData> duplicate(new TestData(42));
+    QCOMPARE(graph.insertVertex(&duplicate), 1);
+    QCOMPARE(graph.getVertexCount(), count);
+
+    // Chain every vertex to the next one
+    for (int i = 0; i + 1 < count; i++) {
+        QCOMPARE(graph.insertEdge(vertices[i], vertices[i + 1]), 0);
+    }
+    QCOMPARE(graph.getEdgeCount(), count - 1);
+    QVERIFY(graph.isAdjacentGraph(&duplicate, vertices[43]));
+    QVERIFY(!graph.isAdjacentGraph(vertices[43], &duplicate));
+
+    // Lookups by an equal, different object go through the index too
+    QVERIFY(graph.findNodeByVertex(&duplicate) != nullptr);
+    QCOMPARE(graph.findNodeByVertex(&duplicate)->data()->vertex, vertices[42]);
+
+    // Remove the last vertex of the chain once its incoming edge is gone
+    BfsVertex<TestData> *last = vertices[count - 1];
+    QCOMPARE(graph.removeVertex(&last), -1);
+    QCOMPARE(graph.removeEdge(vertices[count - 2], &last), 0);
+    QCOMPARE(graph.removeVertex(&last), 0);
+    QCOMPARE(last, vertices[count - 1]);
+    QVERIFY(graph.findNodeByVertex(vertices[count - 1]) == nullptr);
+
+    // The other vertices are still indexed
+    for (int i = 0; i < count - 1; i++) {
+        QVERIFY(graph.findNodeByVertex(vertices[i]) != nullptr);
+    }
+
+    // The removed key can be inserted again
+    QCOMPARE(graph.insertVertex(last, true), 0);
+    QVERIFY(graph.findNodeByVertex(last) != nullptr);
+    QCOMPARE(graph.insertEdge(vertices[0], last), 0);
+
+    // BFS works on hashed graphs
+    List<BfsVertex<TestData>> hops;
+    QCOMPARE(bfs(&graph, vertices[0], hops), 0);
+    QCOMPARE(hops.getSize(), count);
+    QCOMPARE(last->getHops(), 1);
+    QCOMPARE(vertices[10]->getHops(), 10);
+
+    // The graph deletes the vertices it owns, but not their TestData
+    delete duplicate.data;
+    for (int i = 0; i < count; i++) {
+        delete vertices[i]->data;
+        vertices[i]->data = nullptr;
+    }
+}
+
+void TestGraph::testRemoveVertexCascade()
+{
+    Graph<BfsVertex<TestData>, CompareTestData, HashTestData> graph;
+    TestData values[5] = {TestData(0), TestData(1), TestData(2), TestData(3), TestData(4)};
+    BfsVertex<TestData> *vertices[5];
+
+    for (int i = 0; i < 5; i++) {
+        vertices[i] = new BfsVertex<TestData>(&values[i]);
+        QCOMPARE(graph.insertVertex(vertices[i], true), 0);
+    }
+
+    // 0 -> 1, 0 -> 2, 1 -> 2, 3 -> 2, 2 -> 4, 2 -> 2
+    QCOMPARE(graph.insertEdge(vertices[0], vertices[1]), 0);
+    QCOMPARE(graph.insertEdge(vertices[0], vertices[2]), 0);
+    QCOMPARE(graph.insertEdge(vertices[1], vertices[2]), 0);
+    QCOMPARE(graph.insertEdge(vertices[3], vertices[2]), 0);
+    QCOMPARE(graph.insertEdge(vertices[2], vertices[4]), 0);
+    QCOMPARE(graph.insertEdge(vertices[2], vertices[2]), 0);
+
+    // A repeated edge is not added or counted twice
+    QCOMPARE(graph.insertEdge(vertices[0], vertices[1]), 1);
+    QCOMPARE(graph.getEdgeCount(), 6);
+
+    QCOMPARE(graph.getInDegree(vertices[0]), 0);
+    QCOMPARE(graph.getInDegree(vertices[2]), 4);
+    QCOMPARE(graph.getInDegree(vertices[4]), 1);
+
+    // Incoming edges still block a plain removal
+    BfsVertex<TestData> *target = vertices[4];
+    QCOMPARE(graph.removeVertex(&target), -1);
+    QCOMPARE(graph.removeEdge(vertices[2], &target), 0);
+    QCOMPARE(graph.getInDegree(vertices[4]), 0);
+    QCOMPARE(graph.removeVertex(&target), 0);
+    QCOMPARE(target, vertices[4]);
+    delete target;
+
+    // Cascade drops the vertex in the middle with all its edges
+    target = vertices[2];
+    QCOMPARE(graph.removeVertexCascade(&target), 0);
+    QCOMPARE(target, vertices[2]);
+    delete target;
+
+    QCOMPARE(graph.getVertexCount(), 3);
+    QCOMPARE(graph.getEdgeCount(), 1);
+    QVERIFY(graph.isAdjacentGraph(vertices[0], vertices[1]));
+    QVERIFY(!graph.isAdjacentGraph(vertices[1], vertices[2]));
+    QCOMPARE(graph.getInDegree(vertices[1]), 1);
+    BfsVertex<TestData> removed(&values[2]);
+    QCOMPARE(graph.getInDegree(&removed), -1);
+
+    // The remaining vertices keep their order
+    ListNode<AdjacentList<BfsVertex<TestData>, CompareTestData, HashTestData>> *node = graph.getAdjacencyListHead();
+    for (int i : {0, 1, 3}) {
+        QVERIFY(node != nullptr);
+        QCOMPARE(node->data()->vertex, vertices[i]);
+        node = node->next();
+    }
+    QVERIFY(node == nullptr);
+
+    // Removing the tail and the head keeps the list linked for new vertices
+    target = vertices[3];
+    QCOMPARE(graph.removeVertexCascade(&target), 0);
+    delete target;
+    target = vertices[0];
+    QCOMPARE(graph.removeVertexCascade(&target), 0);
+    delete target;
+
+    QCOMPARE(graph.getEdgeCount(), 0);
+    QCOMPARE(graph.getInDegree(vertices[1]), 0);
+
+    vertices[4] = new BfsVertex<TestData>(&values[4]);
+    QCOMPARE(graph.insertVertex(vertices[4], true), 0);
+    QCOMPARE(graph.insertEdge(vertices[4], vertices[1]), 0);
+    target = vertices[1];
+    QCOMPARE(graph.removeVertexCascade(&target), 0);
+    delete target;
+
+    QCOMPARE(graph.getVertexCount(), 1);
+    QCOMPARE(graph.getAdjacencyListHead()->data()->vertex, vertices[4]);
+    QCOMPARE(graph.getAdjacencyListHead()->data()->adjacent.getSize(), 0);
+
+    // Unknown vertices are rejected
+    BfsVertex<TestData> stranger(&values[0]);
+    BfsVertex<TestData> *strangerPtr = &stranger;
+    QCOMPARE(graph.removeVertexCascade(&strangerPtr), -1);
+}
+
+void TestGraph::testDFSLongChain()
+{
+    // A path far deeper than a recursive search could follow on the call stack
+    const int count = 1 << 20;
+    Graph<DfsVertex<int>, CompareDfsInt, HashDfsInt> graph;
+    std::vector<int> values(count);
+    std::vector<DfsVertex<int> *> vertices(count);
+
+    // Vertex 0 is the first root, so a single dfsMain call walks the whole chain
+    for (int i = 0; i < count; i++) {
+        values[i] = i;
+        vertices[i] = new DfsVertex<int>(&values[i]);
+        graph.insertVertex(vertices[i], true);
+    }
+    for (int i = 0; i + 1 < count; i++) {
+        graph.insertEdge(vertices[i], vertices[i + 1]);
+    }
+
+    List<DfsVertex<int>, CompareDfsInt> ordered;
+    QCOMPARE(dfs(&graph, ordered), 0);
+    QCOMPARE(ordered.getSize(), count);
+
+    int i = 0;
+    for (ListNode<DfsVertex<int>> *node = ordered.head(); node != nullptr; node = node->next()) {
+        QCOMPARE(node->data(), vertices[i]);
+        QCOMPARE(node->data()->getColor(), black);
+        i++;
+    }
+
+    // The single-root dfsMain walks the same chain from vertex 0
+    for (int j = 0; j < count; j++) {
+        vertices[j]->setColor(white);
+    }
+    ordered.clear();
+    QCOMPARE(dfsMain(&graph, graph.getAdjacencyListHead()->data(), &ordered), 0);
+    QCOMPARE(ordered.getSize(), count);
+    QCOMPARE(ordered.head()->data(), vertices[0]);
+}
+
+void TestGraph::testEdgeWeights()
+{
+    Graph<int> graph;
+    int values[4] = {0, 1, 2, 3};
+    for (int &value : values) {
+        graph.insertVertex(&value);
+    }
+
+    QCOMPARE(graph.insertWeightedEdge(&values[0], &values[1], 2.5), 0);
+    QCOMPARE(graph.insertEdge(&values[0], &values[2]), 0);
+    QCOMPARE(graph.insertWeightedEdge(&values[1], &values[2], 0.0), 0);
+    QCOMPARE(graph.insertWeightedEdge(&values[2], &values[3], -4.0), 0);
+
+    // A second insert of an edge keeps its weight
+    QCOMPARE(graph.insertWeightedEdge(&values[0], &values[1], 7.0), 1);
+
+    double weight = 0;
+    QCOMPARE(graph.getEdgeWeight(&values[0], &values[1], &weight), 0);
+    QCOMPARE(weight, 2.5);
+    QCOMPARE(graph.getEdgeWeight(&values[0], &values[2], &weight), 0);
+    QCOMPARE(weight, 1.0);  // Unweighted
+    QCOMPARE(graph.getEdgeWeight(&values[1], &values[2], &weight), 0);
+    QCOMPARE(weight, 0.0);
+    QCOMPARE(graph.getEdgeWeight(&values[1], &values[0], &weight), -1);
+
+    // A removed edge loses its weight, so inserting it again weighs 1
+    int *target = &values[1];
+    QCOMPARE(graph.removeEdge(&values[0], &target), 0);
+    QCOMPARE(graph.getEdgeWeight(&values[0], &values[1], &weight), -1);
+    QCOMPARE(graph.insertEdge(&values[0], &values[1]), 0);
+    QCOMPARE(graph.getEdgeWeight(&values[0], &values[1], &weight), 0);
+    QCOMPARE(weight, 1.0);
+
+    // Cascading removal drops the weights of the incoming edges
+    int *removed = &values[2];
+    QCOMPARE(graph.removeVertexCascade(&removed), 0);
+    ListNode<AdjacentList<int>> *node = graph.findNodeByVertex(&values[1]);
+    QVERIFY(node->data()->weights.empty());
+    QCOMPARE(graph.getEdgeCount(), 1);
+}
+
 QTEST_APPLESS_MAIN(TestGraph)
 #include "tst_graph.moc"
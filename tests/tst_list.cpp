@@ -20,6 +20,8 @@ private slots:
     void testEmpty();
     void testEdgeCases();
     void testNullOperations();
+    void testUncheckedOperations();
+    void testContains();
 };
 
 // Simple test data class
@@ -258,5 +260,62 @@ void TestList::testNullOperations() {
     QCOMPARE(list.getSize(), 0);
 }
 
+void TestList::testUncheckedOperations() {
+    List<TestData> list;
+    TestData data1(1), data2(2), data3(3);
+
+    // Append through the trusted path, which keeps the tail up to date
+    list.insertUnchecked(list.tail(), &data1);
+    list.insertUnchecked(list.tail(), &data2);
+    list.insertUnchecked(list.tail(), &data3);
+
+    QCOMPARE(list.getSize(), 3);
+    QCOMPARE(list.head()->data()->value, 1);
+    QCOMPARE(list.tail()->data()->value, 3);
+
+    // Remove the node after the head (data2)
+    TestData* removed = nullptr;
+    list.removeUnchecked(list.head(), &removed);
+    QCOMPARE(removed, &data2);
+    QCOMPARE(list.head()->next(), list.tail());
+
+    // Removing after the tail is still rejected
+    list.removeUnchecked(list.tail(), &removed);
+    QVERIFY(removed == nullptr);
+    QCOMPARE(list.getSize(), 2);
+
+    // Removing the last node after the head moves the tail back
+    list.removeUnchecked(list.head(), &removed);
+    QCOMPARE(removed, &data3);
+    QCOMPARE(list.tail(), list.head());
+
+    list.removeUnchecked(nullptr, &removed);
+    QCOMPARE(removed, &data1);
+    QCOMPARE(list.getSize(), 0);
+    QVERIFY(list.head() == nullptr);
+    QVERIFY(list.tail() == nullptr);
+
+    // Null data is ignored on the trusted path as well
+    list.insertUnchecked(nullptr, nullptr);
+    QCOMPARE(list.getSize(), 0);
+}
+
+void TestList::testContains() {
+    List<TestData> list;
+    TestData data1(1), data2(2);
+
+    QVERIFY(!list.contains(nullptr));
+
+    list.insert(nullptr, &data1);
+    list.insert(list.tail(), &data2);
+
+    QVERIFY(list.contains(list.head()));
+    QVERIFY(list.contains(list.tail()));
+
+    List<TestData> other;
+    other.insert(nullptr, &data1);
+    QVERIFY(!list.contains(other.head()));
+}
+
 QTEST_APPLESS_MAIN(TestList)
 #include "tst_list.moc"
@@ -0,0 +1,163 @@
+#include <QtTest/QtTest>
+#include <random>
+#include <vector>
+#include "../graph.h"
+#include "../csrgraph.h"
+#include "../bfs.h"
+#include "../multisourcebfs.h"
+#include "../traversalstate.h"
+#include "randomgraph.h"
+
+class TestMultiSourceBfs : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Runs before each test function
+    void init();
+
+    // Runs after each test function
+    void cleanup();
+
+    // Test functions - each test is a separate function
+    void testMatchesBfs_data();
+    void testMatchesBfs();
+    void testDuplicateSources();
+    void testStreaming();
+    void testInvalidSources();
+};
+
+// Compare every row of the matrix with a single-source bfs
+static void checkAgainstBfs(const CsrGraph<int> &csr, const std::vector<uint32_t> &sources, const HopMatrix &matrix)
+{
+    QCOMPARE(matrix.sourceCount, sources.size());
+    QCOMPARE(matrix.vertexCount, static_cast<uint32_t>(csr.getVertexCount()));
+
+    BfsState state;
+    for (size_t s = 0; s < sources.size(); s++) {
+        QCOMPARE(bfs(&csr, sources[s], state), 0);
+        for (uint32_t id = 0; id < matrix.vertexCount; id++) {
+            QCOMPARE(matrix.getHops(s, id), state.getHops(id));
+        }
+    }
+}
+
+void TestMultiSourceBfs::init()
+{
+    // Setup code that runs before each test
+}
+
+void TestMultiSourceBfs::cleanup()
+{
+    // Cleanup code that runs after each test
+}
+
+void TestMultiSourceBfs::testMatchesBfs_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("edges");
+    QTest::addColumn<int>("sourceCount");
+
+    // Partial, exactly full and several batches of 64
+    QTest::newRow("one source") << 200 << 500 << 1;
+    QTest::newRow("partial batch") << 300 << 700 << 40;
+    QTest::newRow("full batch") << 300 << 900 << 64;
+    QTest::newRow("three batches") << 500 << 1500 << 150;
+    QTest::newRow("every vertex") << 120 << 200 << 120;
+}
+
+void TestMultiSourceBfs::testMatchesBfs()
+{
+    QFETCH(int, count);
+    QFETCH(int, edges);
+    QFETCH(int, sourceCount);
+
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomGraph(graph, values, count, edges, count * 3 + sourceCount);
+    CsrGraph<int> csr(graph);
+
+    std::mt19937 rng(sourceCount);
+    std::uniform_int_distribution<uint32_t> pick(0, count - 1);
+    std::vector<uint32_t> sources;
+    for (int s = 0; s < sourceCount; s++) {
+        sources.push_back(sourceCount == count ? static_cast<uint32_t>(s) : pick(rng));
+    }
+
+    HopMatrix matrix;
+    QCOMPARE(multiSourceBfs(&csr, sources, matrix), 0);
+    checkAgainstBfs(csr, sources, matrix);
+}
+
+void TestMultiSourceBfs::testDuplicateSources()
+{
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomGraph(graph, values, 100, 300, 2);
+    CsrGraph<int> csr(graph);
+
+    // The same vertex in several lanes of one batch
+    std::vector<uint32_t> sources = {5, 9, 5, 5, 9, 0};
+    HopMatrix matrix;
+    QCOMPARE(multiSourceBfs(&csr, sources, matrix), 0);
+    checkAgainstBfs(csr, sources, matrix);
+
+    // No sources, no rows
+    QCOMPARE(multiSourceBfs(&csr, std::vector<uint32_t>(), matrix), 0);
+    QCOMPARE(matrix.sourceCount, size_t(0));
+    QVERIFY(matrix.hops.empty());
+}
+
+void TestMultiSourceBfs::testStreaming()
+{
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomGraph(graph, values, 400, 1200, 6);
+    CsrGraph<int> csr(graph);
+
+    std::vector<uint32_t> sources;
+    for (uint32_t id = 0; id < 400; id += 3) {
+        sources.push_back(id);
+    }
+
+    HopMatrix matrix;
+    QCOMPARE(multiSourceBfs(&csr, sources, matrix), 0);
+
+    // Each source reports every vertex it reaches once, in level order
+    std::vector<int> visits(sources.size(), 0);
+    std::vector<int> lastHops(sources.size(), 0);
+    bool ordered = true;
+    bool matches = true;
+    int result = multiSourceBfs(&csr, sources, [&](size_t source, uint32_t id, int hops) {
+        visits[source]++;
+        ordered = ordered && hops >= lastHops[source];
+        matches = matches && matrix.getHops(source, id) == hops;
+        lastHops[source] = hops;
+    });
+    QCOMPARE(result, 0);
+    QVERIFY(ordered);
+    QVERIFY(matches);
+
+    for (size_t s = 0; s < sources.size(); s++) {
+        int reached = 0;
+        for (uint32_t id = 0; id < 400; id++) {
+            reached += matrix.getHops(s, id) != -1;
+        }
+        QCOMPARE(visits[s], reached);
+    }
+}
+
+void TestMultiSourceBfs::testInvalidSources()
+{
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomGraph(graph, values, 10, 20, 1);
+    CsrGraph<int> csr(graph);
+
+    HopMatrix matrix;
+    QCOMPARE(multiSourceBfs(&csr, std::vector<uint32_t>{1, 10}, matrix), -1);
+    QCOMPARE(multiSourceBfs(static_cast<const CsrGraph<int> *>(nullptr), std::vector<uint32_t>{1}, matrix), -1);
+}
+
+QTEST_APPLESS_MAIN(TestMultiSourceBfs)
+#include "tst_multisourcebfs.moc"
@@ -0,0 +1,215 @@
+#include <QtTest/QtTest>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "../nodepool.h"
+#include "../list.h"
+#include "../queue.h"
+#include "../set.h"
+
+// Count every call to the global allocation functions so the tests can check
+// that steady state node churn is served entirely from the node pools
+static long heapAllocations = 0;
+
+void* operator new(std::size_t size)
+{
+    heapAllocations++;
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+class TestNodePool : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Runs before each test function
+    void init();
+
+    // Runs after each test function
+    void cleanup();
+
+    // Test functions - each test is a separate function
+    void testReuseFreedNode();
+    void testListSteadyState();
+    void testQueueSteadyState();
+    void testSetSteadyState();
+    void testOwnershipSteadyState();
+    void testHeapAllocator();
+
+private:
+    std::vector<int*> values;
+};
+
+// Number of elements used to warm up the collections
+static const int WORKING_SIZE = 100;
+
+void TestNodePool::init()
+{
+    // Data is allocated up front so only node allocations are counted
+    for (int i = 0; i < WORKING_SIZE; i++) {
+        values.push_back(new int(i));
+    }
+}
+
+void TestNodePool::cleanup()
+{
+    for (int* value : values) {
+        delete value;
+    }
+    values.clear();
+}
+
+void TestNodePool::testReuseFreedNode()
+{
+    PoolAllocator<ListNode<int>> pool;
+
+    ListNode<int>* first = pool.allocate();
+    pool.deallocate(first);
+
+    // The freed slot is handed out again, default constructed
+    ListNode<int>* second = pool.allocate();
+    QCOMPARE(second, first);
+    QVERIFY(second->next() == nullptr);
+    QVERIFY(second->data() == nullptr);
+
+    pool.deallocate(second);
+}
+
+void TestNodePool::testListSteadyState()
+{
+    List<int> list;
+
+    // Warm up: grow the list to its working size once
+    for (int* value : values) {
+        list.insert(list.tail(), value);
+    }
+    list.clear();
+
+    long before = heapAllocations;
+
+    for (int round = 0; round < 10; round++) {
+        for (int* value : values) {
+            list.insert(list.tail(), value);
+        }
+
+        int* removed;
+        while (list.getSize() > 0) {
+            list.remove(nullptr, &removed);
+        }
+    }
+
+    QCOMPARE(heapAllocations - before, 0L);
+}
+
+void TestNodePool::testQueueSteadyState()
+{
+    Queue<int> queue;
+
+    for (int* value : values) {
+        queue.enqueue(value);
+    }
+    queue.clear();
+
+    long before = heapAllocations;
+
+    for (int round = 0; round < 10; round++) {
+        for (int* value : values) {
+            queue.enqueue(value);
+        }
+
+        int* removed;
+        while (!queue.isEmpty()) {
+            queue.dequeue(&removed);
+        }
+    }
+
+    QCOMPARE(heapAllocations - before, 0L);
+}
+
+void TestNodePool::testSetSteadyState()
+{
+    Set<int> set;
+
+    for (int* value : values) {
+        set.insert(value);
+    }
+    for (int* value : values) {
+        set.remove(value);
+    }
+
+    long before = heapAllocations;
+
+    for (int round = 0; round < 10; round++) {
+        for (int* value : values) {
+            set.insert(value);
+        }
+        for (int* value : values) {
+            set.remove(value);
+        }
+    }
+
+    QCOMPARE(set.getSize(), 0);
+    QCOMPARE(heapAllocations - before, 0L);
+}
+
+void TestNodePool::testOwnershipSteadyState()
+{
+    List<int> list;
+
+    // The ownership table only grows, so once it has seen the working size
+    // taking and releasing ownership does not allocate either
+    for (int* value : values) {
+        list.insert(list.tail(), value, true);
+    }
+
+    int* removed;
+    while (list.getSize() > 0) {
+        list.remove(nullptr, &removed);
+    }
+
+    long before = heapAllocations;
+
+    for (int round = 0; round < 10; round++) {
+        for (int* value : values) {
+            list.insert(list.tail(), value, true);
+        }
+        while (list.getSize() > 0) {
+            list.remove(nullptr, &removed);
+        }
+    }
+
+    QCOMPARE(heapAllocations - before, 0L);
+}
+
+void TestNodePool::testHeapAllocator()
+{
+    // Sanity check of the counter: the heap allocator allocates on every insert
+    List<int, std::equal_to<int>, HeapAllocator> list;
+
+    long before = heapAllocations;
+
+    for (int* value : values) {
+        list.insert(list.tail(), value);
+    }
+
+    QCOMPARE(heapAllocations - before, long(WORKING_SIZE));
+
+    list.clear();
+}
+
+QTEST_APPLESS_MAIN(TestNodePool)
+#include "tst_nodepool.moc"
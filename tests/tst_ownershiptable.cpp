@@ -0,0 +1,173 @@
+#include <QtTest/QtTest>
+#include <vector>
+#include "../ownershiptable.h"
+#include "../list.h"
+
+class TestOwnershipTable : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Runs before each test function
+    void init();
+
+    // Runs after each test function
+    void cleanup();
+
+    // Test functions - each test is a separate function
+    void testInsertAndContains();
+    void testDuplicateInsert();
+    void testRemove();
+    void testGrowth();
+    void testRemoveKeepsProbeChains();
+    void testClear();
+    void testCollectionOwnership();
+};
+
+void TestOwnershipTable::init()
+{
+    // Setup code that runs before each test
+}
+
+void TestOwnershipTable::cleanup()
+{
+    // Cleanup code that runs after each test
+}
+
+void TestOwnershipTable::testInsertAndContains()
+{
+    OwnershipTable<int> table;
+    int a = 1, b = 2;
+
+    // An empty table has no slots and contains nothing
+    QCOMPARE(table.getSize(), size_t(0));
+    QCOMPARE(table.getCapacity(), size_t(0));
+    QVERIFY(!table.contains(&a));
+
+    QVERIFY(table.insert(&a));
+    QVERIFY(table.contains(&a));
+    QVERIFY(!table.contains(&b));
+    QCOMPARE(table.getSize(), size_t(1));
+}
+
+void TestOwnershipTable::testDuplicateInsert()
+{
+    OwnershipTable<int> table;
+    int a = 1;
+
+    QVERIFY(table.insert(&a));
+    QVERIFY(!table.insert(&a)); // Second insert is a no-op
+    QCOMPARE(table.getSize(), size_t(1));
+}
+
+void TestOwnershipTable::testRemove()
+{
+    OwnershipTable<int> table;
+    int a = 1, b = 2;
+
+    table.insert(&a);
+    table.insert(&b);
+
+    QVERIFY(table.remove(&a));
+    QVERIFY(!table.contains(&a));
+    QVERIFY(table.contains(&b));
+    QCOMPARE(table.getSize(), size_t(1));
+
+    // Removing a pointer that isn't stored fails
+    QVERIFY(!table.remove(&a));
+    QCOMPARE(table.getSize(), size_t(1));
+}
+
+void TestOwnershipTable::testGrowth()
+{
+    OwnershipTable<int> table;
+    std::vector<int> values(10000);
+
+    for (int& value : values) {
+        QVERIFY(table.insert(&value));
+    }
+
+    QCOMPARE(table.getSize(), values.size());
+
+    // The load factor never goes above 1/2
+    QVERIFY(table.getCapacity() >= values.size() * 2);
+
+    for (int& value : values) {
+        QVERIFY(table.contains(&value));
+    }
+}
+
+void TestOwnershipTable::testRemoveKeepsProbeChains()
+{
+    OwnershipTable<int> table;
+    std::vector<int> values(5000);
+
+    for (int& value : values) {
+        table.insert(&value);
+    }
+
+    // Remove every other element, then check the survivors can still be found
+    for (size_t i = 0; i < values.size(); i += 2) {
+        QVERIFY(table.remove(&values[i]));
+    }
+
+    for (size_t i = 0; i < values.size(); i++) {
+        QCOMPARE(table.contains(&values[i]), i % 2 == 1);
+    }
+
+    QCOMPARE(table.getSize(), values.size() / 2);
+}
+
+void TestOwnershipTable::testClear()
+{
+    OwnershipTable<int> table;
+    int a = 1;
+
+    table.insert(&a);
+    table.clear();
+
+    QCOMPARE(table.getSize(), size_t(0));
+    QVERIFY(!table.contains(&a));
+
+    // The table is usable again after clearing
+    QVERIFY(table.insert(&a));
+    QVERIFY(table.contains(&a));
+}
+
+void TestOwnershipTable::testCollectionOwnership()
+{
+    List<int> list;
+    int* owned = new int(1);
+    int* notOwned = new int(2);
+
+    list.insert(nullptr, owned, true);
+    list.insert(nullptr, notOwned, false);
+
+    QVERIFY(list.hasOwnership(owned));
+    QVERIFY(!list.hasOwnership(notOwned));
+    QVERIFY(!list.hasOwnership(nullptr));
+
+    // Taking ownership twice keeps a single entry
+    list.takeOwnership(owned);
+    list.releaseOwnership(owned);
+    QVERIFY(!list.hasOwnership(owned));
+
+    // Releasing something we never owned is a no-op
+    list.releaseOwnership(notOwned);
+    list.takeOwnership(owned);
+    QVERIFY(list.hasOwnership(owned));
+
+    // Removing an element hands the data back and releases ownership
+    int* removed = nullptr;
+    list.remove(nullptr, &removed);
+    QCOMPARE(removed, notOwned);
+    list.remove(nullptr, &removed);
+    QCOMPARE(removed, owned);
+    QVERIFY(!list.hasOwnership(owned));
+
+    delete owned;
+    delete notOwned;
+}
+
+QTEST_APPLESS_MAIN(TestOwnershipTable)
+#include "tst_ownershiptable.moc"
@@ -0,0 +1,260 @@
+#include <QtTest/QtTest>
+#include <cmath>
+#include <vector>
+#include "../graph.h"
+#include "../csrgraph.h"
+#include "../pagerank.h"
+#include "../threadpool.h"
+#include "randomgraph.h"
+
+class TestPageRank : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Runs before each test function
+    void init();
+
+    // Runs after each test function
+    void cleanup();
+
+    // Test functions - each test is a separate function
+    void testCycle();
+    void testDanglingVertices();
+    void testMatchesReference_data();
+    void testMatchesReference();
+    void testThreadCountIndependent();
+    void testIterationReport();
+    void testInvalidInput();
+    void testGraphOverload();
+};
+
+// PageRank pushing each vertex's rank along its out-edges, for a fixed
+// number of iterations
+static std::vector<double> referencePageRank(const CsrGraph<int> &csr, double damping, int iterations)
+{
+    size_t count = static_cast<size_t>(csr.getVertexCount());
+    std::vector<double> rank(count, 1.0 / count);
+
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        std::vector<double> next(count, 0.0);
+        double dangling = 0;
+
+        for (uint32_t id = 0; id < count; id++) {
+            if (csr.degree(id) == 0) {
+                dangling += rank[id];
+            }
+            for (const uint32_t *adj = csr.adjacentBegin(id); adj != csr.adjacentEnd(id); adj++) {
+                next[*adj] += rank[id] / csr.degree(id);
+            }
+        }
+        for (size_t id = 0; id < count; id++) {
+            next[id] = (1 - damping) / count + damping * (next[id] + dangling / count);
+        }
+        rank.swap(next);
+    }
+
+    return rank;
+}
+
+static double total(const std::vector<double> &ranks)
+{
+    double sum = 0;
+    for (double rank : ranks) {
+        sum += rank;
+    }
+    return sum;
+}
+
+void TestPageRank::init()
+{
+    // Setup code that runs before each test
+}
+
+void TestPageRank::cleanup()
+{
+    // Cleanup code that runs after each test
+}
+
+void TestPageRank::testCycle()
+{
+    // Every vertex of a cycle ranks the same
+    IntGraph graph;
+    int values[5] = {0, 1, 2, 3, 4};
+    for (int &value : values) {
+        graph.insertVertex(&value);
+    }
+    for (int i = 0; i < 5; i++) {
+        graph.insertEdge(&values[i], &values[(i + 1) % 5]);
+    }
+
+    CsrGraph<int> csr(graph);
+    ThreadPool pool(2);
+    PageRank result;
+    QCOMPARE(pageRank(&csr, result, pool), 0);
+    QVERIFY(result.isConverged());
+    for (uint32_t id = 0; id < 5; id++) {
+        QVERIFY(std::fabs(result.getRank(id) - 0.2) < 1e-15);
+    }
+}
+
+void TestPageRank::testDanglingVertices()
+{
+    // 0 and 1 link to 2, which links nowhere; its rank is spread evenly
+    IntGraph graph;
+    int values[3] = {0, 1, 2};
+    for (int &value : values) {
+        graph.insertVertex(&value);
+    }
+    graph.insertEdge(&values[0], &values[2]);
+    graph.insertEdge(&values[1], &values[2]);
+
+    CsrGraph<int> csr(graph);
+    ThreadPool pool(2);
+    PageRank result;
+    QCOMPARE(pageRank(&csr, result, pool, 0.5, 1e-14), 0);
+
+    // r0 = r1 = 1/6 + r2/6 and r2 = 1/6 + (r0 + r1)/2 + r2/6
+    QVERIFY(std::fabs(result.getRank(0) - 0.25) < 1e-12);
+    QVERIFY(std::fabs(result.getRank(1) - 0.25) < 1e-12);
+    QVERIFY(std::fabs(result.getRank(2) - 0.5) < 1e-12);
+    QVERIFY(std::fabs(total(result.ranks) - 1) < 1e-12);
+}
+
+void TestPageRank::testMatchesReference_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("edges");
+    QTest::addColumn<int>("threads");
+
+    // Sparse graphs have many dangling vertices, dense ones long gathers
+    QTest::newRow("sparse") << 5000 << 4000 << 2;
+    QTest::newRow("dense") << 2000 << 40000 << 3;
+    QTest::newRow("several blocks") << 20000 << 100000 << 4;
+    QTest::newRow("single thread") << 3000 << 9000 << 1;
+}
+
+void TestPageRank::testMatchesReference()
+{
+    QFETCH(int, count);
+    QFETCH(int, edges);
+    QFETCH(int, threads);
+
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomGraph(graph, values, count, edges, count + edges);
+    CsrGraph<int> csr(graph);
+
+    ThreadPool pool(threads);
+    PageRank result;
+    QCOMPARE(pageRank(&csr, result, pool, 0.85, 1e-13, 200), 0);
+    std::vector<double> expected = referencePageRank(csr, 0.85, result.getIterationCount());
+
+    for (SimdLevel level : {SimdScalar, detectSimdLevel()}) {
+        PageRank atLevel;
+        QCOMPARE(pageRank(&csr, atLevel, pool, 0.85, 1e-13, 200, level), 0);
+        for (int id = 0; id < count; id++) {
+            QVERIFY(std::fabs(atLevel.getRank(id) - expected[id]) < 1e-12);
+        }
+        QVERIFY(std::fabs(total(atLevel.ranks) - 1) < 1e-9);
+    }
+}
+
+void TestPageRank::testThreadCountIndependent()
+{
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomGraph(graph, values, 10000, 60000, 5);
+    CsrGraph<int> csr(graph);
+
+    ThreadPool single(1);
+    PageRank expected;
+    QCOMPARE(pageRank(&csr, expected, single), 0);
+
+    // Bit for bit the same ranks and iterations on any number of threads
+    for (int threads : {2, 3, 5}) {
+        ThreadPool pool(threads);
+        PageRank result;
+        QCOMPARE(pageRank(&csr, result, pool), 0);
+        QVERIFY(result.ranks == expected.ranks);
+        QCOMPARE(result.getIterationCount(), expected.getIterationCount());
+    }
+}
+
+void TestPageRank::testIterationReport()
+{
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomGraph(graph, values, 3000, 15000, 8);
+    CsrGraph<int> csr(graph);
+    ThreadPool pool(2);
+
+    // Too few iterations to converge still gives ranks, and returns 1
+    PageRank result;
+    QCOMPARE(pageRank(&csr, result, pool, 0.85, 1e-12, 3), 1);
+    QVERIFY(!result.isConverged());
+    QCOMPARE(result.getIterationCount(), 3);
+    QVERIFY(std::fabs(total(result.ranks) - 1) < 1e-9);
+
+    QCOMPARE(pageRank(&csr, result, pool, 0.85, 1e-10), 0);
+    QVERIFY(result.getIterationCount() > 3);
+    QVERIFY(result.iterations.back().residual < 1e-10);
+    QVERIFY(result.iterations.front().residual > result.iterations.back().residual);
+
+    double seconds = 0;
+    for (const PageRankIteration &iteration : result.iterations) {
+        QVERIFY(iteration.seconds >= 0);
+        seconds += iteration.seconds;
+    }
+    QCOMPARE(result.getSeconds(), seconds);
+
+    // Without damping every vertex ranks the same after one iteration
+    QCOMPARE(pageRank(&csr, result, pool, 0.0), 0);
+    QCOMPARE(result.getIterationCount(), 1);
+}
+
+void TestPageRank::testInvalidInput()
+{
+    IntGraph graph;
+    int value = 0;
+    graph.insertVertex(&value);
+    CsrGraph<int> csr(graph);
+    ThreadPool pool(2);
+    PageRank result;
+
+    QCOMPARE(pageRank(&csr, result, pool, 1.0), -1);
+    QCOMPARE(pageRank(&csr, result, pool, -0.1), -1);
+    QCOMPARE(pageRank(&csr, result, pool, 0.85, -1.0), -1);
+    QCOMPARE(pageRank(&csr, result, pool, 0.85, 1e-6, 0), -1);
+    QCOMPARE(pageRank(static_cast<const CsrGraph<int> *>(nullptr), result, pool), -1);
+
+    // A single dangling vertex keeps all the rank
+    QCOMPARE(pageRank(&csr, result, pool), 0);
+    QCOMPARE(result.getRank(0), 1.0);
+
+    IntGraph empty;
+    CsrGraph<int> emptyCsr(empty);
+    QCOMPARE(pageRank(&emptyCsr, result, pool), 0);
+    QVERIFY(result.ranks.empty());
+    QVERIFY(result.isConverged());
+}
+
+void TestPageRank::testGraphOverload()
+{
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomGraph(graph, values, 400, 1600, 9);
+    CsrGraph<int> csr(graph);
+    ThreadPool pool(2);
+
+    PageRank fromCsr;
+    PageRank fromGraph;
+    QCOMPARE(pageRank(&csr, fromCsr, pool), 0);
+    QCOMPARE(pageRank(&graph, fromGraph, pool), 0);
+    QVERIFY(fromGraph.ranks == fromCsr.ranks);
+
+    QCOMPARE(pageRank(static_cast<IntGraph *>(nullptr), fromGraph, pool), -1);
+}
+
+QTEST_APPLESS_MAIN(TestPageRank)
+#include "tst_pagerank.moc"
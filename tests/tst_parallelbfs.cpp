@@ -0,0 +1,210 @@
+#include <QtTest/QtTest>
+#include <atomic>
+#include <vector>
+#include "../graph.h"
+#include "../csrgraph.h"
+#include "../bfs.h"
+#include "../parallelbfs.h"
+#include "../threadpool.h"
+#include "../bfsvertex.h"
+#include "randomgraph.h"
+
+class TestParallelBfs : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Runs before each test function
+    void init();
+
+    // Runs after each test function
+    void cleanup();
+
+    // Test functions - each test is a separate function
+    void testThreadPool();
+    void testBarrier();
+    void testParallelFor();
+    void testMatchesBfs_data();
+    void testMatchesBfs();
+    void testGraphOverload();
+    void testUnknownStart();
+};
+
+void TestParallelBfs::init()
+{
+    // Setup code that runs before each test
+}
+
+void TestParallelBfs::cleanup()
+{
+    // Cleanup code that runs after each test
+}
+
+void TestParallelBfs::testThreadPool()
+{
+    ThreadPool single(1);
+    QCOMPARE(single.getThreadCount(), 1u);
+
+    ThreadPool pool(4);
+    QCOMPARE(pool.getThreadCount(), 4u);
+
+    // Every thread runs every task once, and run waits for all of them
+    std::vector<int> runs(4, 0);
+    for (int task = 0; task < 100; task++) {
+        pool.run([&](unsigned thread) {
+            runs[thread]++;
+        });
+    }
+
+    for (int count : runs) {
+        QCOMPARE(count, 100);
+    }
+
+    // The default pool has at least one thread
+    ThreadPool automatic;
+    QVERIFY(automatic.getThreadCount() >= 1);
+}
+
+void TestParallelBfs::testBarrier()
+{
+    ThreadPool pool(4);
+    std::vector<int> written(4, 0);
+    std::atomic<int> mismatches(0);
+
+    // Each phase reads what the other threads wrote in the previous one
+    pool.run([&](unsigned thread) {
+        for (int phase = 1; phase <= 200; phase++) {
+            written[thread] = phase;
+            pool.barrier();
+
+            for (int value : written) {
+                if (value != phase) {
+                    mismatches++;
+                }
+            }
+            pool.barrier();
+        }
+    });
+
+    QCOMPARE(mismatches.load(), 0);
+}
+
+void TestParallelBfs::testParallelFor()
+{
+    ThreadPool pool(4);
+
+    // Every index is visited exactly once, whatever the chunk size
+    for (size_t chunk : {size_t(1), size_t(7), parallelChunk, size_t(5000)}) {
+        std::vector<std::atomic<int>> visits(1000);
+        parallelFor(pool, visits.size(), chunk, [&](unsigned, size_t i) {
+            visits[i]++;
+        });
+
+        for (const std::atomic<int> &count : visits) {
+            QCOMPARE(count.load(), 1);
+        }
+    }
+
+    // Nothing to do for an empty range
+    bool visited = false;
+    parallelFor(pool, 0, parallelChunk, [&](unsigned, size_t) {
+        visited = true;
+    });
+    QVERIFY(!visited);
+}
+
+void TestParallelBfs::testMatchesBfs_data()
+{
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("edges");
+
+    QTest::newRow("1 thread") << 1 << 2000 << 6000;
+    QTest::newRow("2 threads") << 2 << 2000 << 6000;
+    QTest::newRow("4 threads") << 4 << 5000 << 40000;
+    QTest::newRow("8 threads sparse") << 8 << 5000 << 5000;
+    QTest::newRow("8 threads tiny") << 8 << 3 << 1;
+}
+
+void TestParallelBfs::testMatchesBfs()
+{
+    QFETCH(int, threads);
+    QFETCH(int, count);
+    QFETCH(int, edges);
+
+    BfsGraph graph;
+    std::vector<int> values;
+    std::vector<BfsVertex<int> *> vertices;
+    buildRandomGraph(graph, values, vertices, count, edges, count + edges);
+
+    CsrGraph<BfsVertex<int>> csr(graph);
+    ThreadPool pool(threads);
+
+    for (int start : {0, count / 2}) {
+        List<BfsVertex<int>> expectedHops;
+        QCOMPARE(bfs(&graph, vertices[start], expectedHops), 0);
+
+        std::vector<int> expected;
+        for (BfsVertex<int> *vertex : vertices) {
+            expected.push_back(vertex->getHops());
+            vertex->setHops(-7);
+        }
+
+        List<BfsVertex<int>> parallelHops;
+        QCOMPARE(parallelBfs(&csr, vertices[start], parallelHops, pool), 0);
+        QCOMPARE(parallelHops.getSize(), expectedHops.getSize());
+
+        for (size_t i = 0; i < vertices.size(); i++) {
+            QCOMPARE(vertices[i]->getHops(), expected[i]);
+            QCOMPARE(vertices[i]->getColor(), expected[i] == -1 ? white : black);
+        }
+    }
+}
+
+void TestParallelBfs::testGraphOverload()
+{
+    BfsGraph graph;
+    std::vector<int> values;
+    std::vector<BfsVertex<int> *> vertices;
+    buildRandomGraph(graph, values, vertices, 500, 1500, 9);
+
+    List<BfsVertex<int>> expectedHops;
+    QCOMPARE(bfs(&graph, vertices[3], expectedHops), 0);
+
+    std::vector<int> expected;
+    for (BfsVertex<int> *vertex : vertices) {
+        expected.push_back(vertex->getHops());
+    }
+
+    // The start can be any object equal to a vertex of the graph
+    int three = 3;
+    BfsVertex<int> start(&three);
+    ThreadPool pool(3);
+    List<BfsVertex<int>> hops;
+    QCOMPARE(parallelBfs(&graph, &start, hops, pool), 0);
+    QCOMPARE(hops.getSize(), expectedHops.getSize());
+
+    for (size_t i = 0; i < vertices.size(); i++) {
+        QCOMPARE(vertices[i]->getHops(), expected[i]);
+    }
+}
+
+void TestParallelBfs::testUnknownStart()
+{
+    BfsGraph graph;
+    int value = 1;
+    int other = 2;
+    graph.insertVertex(new BfsVertex<int>(&value), true);
+
+    ThreadPool pool(2);
+    List<BfsVertex<int>> hops;
+    BfsVertex<int> stranger(&other);
+    QCOMPARE(parallelBfs(&graph, &stranger, hops, pool), -1);
+    QCOMPARE(parallelBfs(&graph, static_cast<BfsVertex<int> *>(nullptr), hops, pool), -1);
+
+    CsrGraph<BfsVertex<int>> csr(graph);
+    QCOMPARE(parallelBfs(&csr, &stranger, hops, pool), -1);
+}
+
+QTEST_APPLESS_MAIN(TestParallelBfs)
+#include "tst_parallelbfs.moc"
@@ -15,6 +15,9 @@ private slots:
     void testNullPointers();   // Test null pointer handling
     void testClear();          // Test clearing the queue
     void testPeekEmpty();      // Test peeking on empty queue
+    void testWrapAround();     // Test FIFO order when the buffer wraps and grows
+    void testReserve();        // Test pre-sizing the buffer
+    void testOwnership();      // Test ownership of queued elements
 };
 
 void TestQueue::init()
@@ -154,5 +157,84 @@ void TestQueue::testPeekEmpty()
     QVERIFY(queue.peek() == nullptr);
 }
 
+void TestQueue::testWrapAround()
+{
+    Queue<int> queue;
+    int values[100];
+    for (int i = 0; i < 100; i++) {
+        values[i] = i;
+    }
+
+    // Keep the queue partly full while cycling through it, so the front
+    // moves around the buffer and the buffer grows while wrapped
+    int next = 0;
+    int expected = 0;
+    int* data = nullptr;
+    for (int round = 0; round < 20; round++) {
+        for (int i = 0; i < 5; i++) {
+            queue.enqueue(&values[next++ % 100]);
+        }
+        for (int i = 0; i < 3; i++) {
+            queue.dequeue(&data);
+            QCOMPARE(*data, expected++ % 100);
+        }
+    }
+
+    QCOMPARE(queue.getSize(), 40);
+
+    while (!queue.isEmpty()) {
+        queue.dequeue(&data);
+        QCOMPARE(*data, expected++ % 100);
+    }
+
+    QCOMPARE(expected, next);
+}
+
+void TestQueue::testReserve()
+{
+    Queue<int> queue;
+    int value = 7;
+
+    queue.reserve(1000);
+    QVERIFY(queue.getCapacity() >= 1000);
+    size_t capacity = queue.getCapacity();
+
+    for (int i = 0; i < 1000; i++) {
+        queue.enqueue(&value);
+    }
+
+    // No reallocation happened while filling the reserved space
+    QCOMPARE(queue.getCapacity(), capacity);
+    QCOMPARE(queue.getSize(), 1000);
+
+    // Reserving less than the capacity is a no-op
+    queue.reserve(10);
+    QCOMPARE(queue.getCapacity(), capacity);
+
+    queue.clear();
+    QVERIFY(queue.isEmpty());
+}
+
+void TestQueue::testOwnership()
+{
+    int* removed = nullptr;
+
+    {
+        Queue<int> queue;
+        queue.enqueue(new int(1), true);
+        queue.enqueue(new int(2), true);
+
+        QVERIFY(queue.hasOwnership(queue.peek()));
+
+        // Dequeueing hands the element and its ownership back to the caller
+        queue.dequeue(&removed);
+        QVERIFY(!queue.hasOwnership(removed));
+    }
+    // The queue deleted the element it still owned when it went out of scope
+
+    QCOMPARE(*removed, 1);
+    delete removed;
+}
+
 QTEST_APPLESS_MAIN(TestQueue)
 #include "tst_queue.moc"
\ No newline at end of file
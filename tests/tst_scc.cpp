@@ -0,0 +1,321 @@
+#include <QtTest/QtTest>
+#include <random>
+#include <vector>
+#include "../graph.h"
+#include "../csrgraph.h"
+#include "../bfs.h"
+#include "../scc.h"
+#include "../threadpool.h"
+#include "../traversalstate.h"
+#include "randomgraph.h"
+
+class TestScc : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Runs before each test function
+    void init();
+
+    // Runs after each test function
+    void cleanup();
+
+    // Test functions - each test is a separate function
+    void testSmallGraph();
+    void testMatchesReachability_data();
+    void testMatchesReachability();
+    void testBlocks_data();
+    void testBlocks();
+    void testLongPaths();
+    void testGraphOverload();
+};
+
+// Check the condensation against the graph: every vertex is listed once
+// under its component, and the component edges are exactly the edges of
+// the graph between different components, going from lower to higher IDs
+static void checkCondensation(const CsrGraph<int> &csr, const Condensation &condensation)
+{
+    uint32_t vertexCount = static_cast<uint32_t>(csr.getVertexCount());
+    uint32_t componentCount = condensation.getComponentCount();
+    QCOMPARE(static_cast<uint32_t>(condensation.component.size()), vertexCount);
+
+    uint32_t listed = 0;
+    for (uint32_t c = 0; c < componentCount; c++) {
+        QVERIFY(condensation.membersBegin(c) != condensation.membersEnd(c));
+        for (const uint32_t *member = condensation.membersBegin(c); member != condensation.membersEnd(c); member++) {
+            QCOMPARE(condensation.getComponent(*member), c);
+            listed++;
+        }
+
+        for (const uint32_t *d = condensation.edgesBegin(c); d != condensation.edgesEnd(c); d++) {
+            QVERIFY(*d > c);
+            QVERIFY(d + 1 == condensation.edgesEnd(c) || *d < *(d + 1));
+        }
+    }
+    QCOMPARE(listed, vertexCount);
+
+    for (uint32_t id = 0; id < vertexCount; id++) {
+        uint32_t c = condensation.getComponent(id);
+        for (const uint32_t *adj = csr.adjacentBegin(id); adj != csr.adjacentEnd(id); adj++) {
+            uint32_t d = condensation.getComponent(*adj);
+            if (d != c) {
+                QVERIFY(std::binary_search(condensation.edgesBegin(c), condensation.edgesEnd(c), d));
+            }
+        }
+    }
+}
+
+// Check that two vertices share a component exactly when each reaches the other
+static void checkAgainstReachability(const CsrGraph<int> &csr, const Condensation &condensation)
+{
+    uint32_t vertexCount = static_cast<uint32_t>(csr.getVertexCount());
+    std::vector<std::vector<bool>> reaches(vertexCount, std::vector<bool>(vertexCount, false));
+
+    BfsState state;
+    for (uint32_t source = 0; source < vertexCount; source++) {
+        QCOMPARE(bfs(&csr, source, state), 0);
+        for (uint32_t id : state.reached) {
+            reaches[source][id] = true;
+        }
+    }
+
+    for (uint32_t u = 0; u < vertexCount; u++) {
+        for (uint32_t v = 0; v < vertexCount; v++) {
+            bool together = condensation.getComponent(u) == condensation.getComponent(v);
+            QCOMPARE(together, reaches[u][v] && reaches[v][u]);
+        }
+    }
+}
+
+// Check that two results put the same vertices together
+static void checkSamePartition(const Condensation &expected, const Condensation &actual)
+{
+    QCOMPARE(actual.getComponentCount(), expected.getComponentCount());
+    QCOMPARE(actual.component.size(), expected.component.size());
+
+    std::vector<uint32_t> mapped(expected.getComponentCount(), CsrGraph<int>::noVertex);
+    for (size_t id = 0; id < expected.component.size(); id++) {
+        uint32_t &target = mapped[expected.component[id]];
+        if (target == CsrGraph<int>::noVertex) {
+            target = actual.component[id];
+        }
+        QCOMPARE(actual.component[id], target);
+    }
+}
+
+void TestScc::init()
+{
+    // Setup code that runs before each test
+}
+
+void TestScc::cleanup()
+{
+    // Cleanup code that runs after each test
+}
+
+void TestScc::testSmallGraph()
+{
+    IntGraph graph;
+    int values[7] = {0, 1, 2, 3, 4, 5, 6};
+    for (int &value : values) {
+        graph.insertVertex(&value);
+    }
+
+    // {0, 1, 2} -> {3, 4} <- {5}, 5 with a self loop, 6 alone
+    graph.insertEdge(&values[0], &values[1]);
+    graph.insertEdge(&values[1], &values[2]);
+    graph.insertEdge(&values[2], &values[0]);
+    graph.insertEdge(&values[2], &values[3]);
+    graph.insertEdge(&values[3], &values[4]);
+    graph.insertEdge(&values[4], &values[3]);
+    graph.insertEdge(&values[5], &values[4]);
+    graph.insertEdge(&values[5], &values[5]);
+
+    CsrGraph<int> csr(graph);
+    ThreadPool pool(2);
+    Condensation sequential;
+    Condensation parallel;
+    QCOMPARE(scc(&csr, sequential), 0);
+    QCOMPARE(parallelScc(&csr, parallel, pool), 0);
+
+    for (Condensation *condensation : {&sequential, &parallel}) {
+        QCOMPARE(condensation->getComponentCount(), 4u);
+        checkCondensation(csr, *condensation);
+
+        uint32_t cycle = condensation->getComponent(0);
+        uint32_t pair = condensation->getComponent(3);
+        QCOMPARE(condensation->getComponent(1), cycle);
+        QCOMPARE(condensation->getComponent(2), cycle);
+        QCOMPARE(condensation->getComponent(4), pair);
+        QVERIFY(condensation->getComponent(5) < pair);
+
+        QCOMPARE(condensation->edgesEnd(cycle) - condensation->edgesBegin(cycle), 1);
+        QCOMPARE(*condensation->edgesBegin(cycle), pair);
+        QCOMPARE(condensation->membersEnd(cycle) - condensation->membersBegin(cycle), 3);
+    }
+    checkSamePartition(sequential, parallel);
+
+    // An empty graph has no components
+    IntGraph empty;
+    CsrGraph<int> emptyCsr(empty);
+    QCOMPARE(scc(&emptyCsr, sequential), 0);
+    QCOMPARE(sequential.getComponentCount(), 0u);
+    QCOMPARE(parallelScc(&emptyCsr, parallel, pool), 0);
+    QCOMPARE(parallel.getComponentCount(), 0u);
+
+    QCOMPARE(scc(static_cast<const CsrGraph<int> *>(nullptr), sequential), -1);
+}
+
+void TestScc::testMatchesReachability_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("edges");
+    QTest::addColumn<int>("threads");
+
+    // Below, around and above one edge per vertex, where the giant component appears
+    QTest::newRow("sparse") << 300 << 240 << 2;
+    QTest::newRow("critical") << 300 << 330 << 3;
+    QTest::newRow("dense") << 200 << 800 << 4;
+    QTest::newRow("single thread") << 250 << 300 << 1;
+}
+
+void TestScc::testMatchesReachability()
+{
+    QFETCH(int, count);
+    QFETCH(int, edges);
+    QFETCH(int, threads);
+
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomGraph(graph, values, count, edges, count + edges);
+    CsrGraph<int> csr(graph);
+
+    Condensation sequential;
+    QCOMPARE(scc(&csr, sequential), 0);
+    checkCondensation(csr, sequential);
+    checkAgainstReachability(csr, sequential);
+
+    ThreadPool pool(threads);
+    Condensation parallel;
+    QCOMPARE(parallelScc(&csr, parallel, pool), 0);
+    checkCondensation(csr, parallel);
+    checkSamePartition(sequential, parallel);
+}
+
+void TestScc::testBlocks_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("4 threads") << 4;
+}
+
+void TestScc::testBlocks()
+{
+    QFETCH(int, threads);
+
+    // Many cycles of different sizes joined by forward edges, with the
+    // vertex numbers shuffled, so coloring needs several rounds
+    const int count = 20000;
+    std::mt19937 rng(8);
+    std::vector<int> position(count);
+    for (int i = 0; i < count; i++) {
+        position[i] = i;
+    }
+    std::shuffle(position.begin(), position.end(), rng);
+
+    IntGraph graph;
+    std::vector<int> values(count);
+    for (int i = 0; i < count; i++) {
+        values[i] = i;
+        graph.insertVertex(&values[i]);
+    }
+
+    int blockStart = 0;
+    std::uniform_int_distribution<int> blockSize(1, 40);
+    while (blockStart < count) {
+        int blockEnd = std::min(count, blockStart + blockSize(rng));
+        for (int i = blockStart; i < blockEnd; i++) {
+            int next = i + 1 < blockEnd ? i + 1 : blockStart;
+            graph.insertEdge(&values[position[i]], &values[position[next]]);
+        }
+        if (blockEnd < count) {
+            std::uniform_int_distribution<int> later(blockEnd, count - 1);
+            graph.insertEdge(&values[position[blockStart]], &values[position[later(rng)]]);
+        }
+        blockStart = blockEnd;
+    }
+
+    CsrGraph<int> csr(graph);
+    Condensation sequential;
+    QCOMPARE(scc(&csr, sequential), 0);
+    checkCondensation(csr, sequential);
+
+    ThreadPool pool(threads);
+    Condensation parallel;
+    QCOMPARE(parallelScc(&csr, parallel, pool), 0);
+    checkCondensation(csr, parallel);
+    checkSamePartition(sequential, parallel);
+}
+
+void TestScc::testLongPaths()
+{
+    // A path and a cycle far longer than a recursive search could follow
+    const int count = 1 << 18;
+    IntGraph graph;
+    std::vector<int> values(count);
+    for (int i = 0; i < count; i++) {
+        values[i] = i;
+        graph.insertVertex(&values[i]);
+    }
+    for (int i = 0; i + 1 < count; i++) {
+        graph.insertEdge(&values[i], &values[i + 1]);
+    }
+
+    ThreadPool pool(2);
+    CsrGraph<int> path(graph);
+    Condensation sequential;
+    Condensation parallel;
+    QCOMPARE(scc(&path, sequential), 0);
+    QCOMPARE(sequential.getComponentCount(), static_cast<uint32_t>(count));
+    QCOMPARE(parallelScc(&path, parallel, pool), 0);
+    QCOMPARE(parallel.getComponentCount(), static_cast<uint32_t>(count));
+
+    // Components follow the path in order
+    for (uint32_t id = 0; id < static_cast<uint32_t>(count); id++) {
+        QCOMPARE(sequential.getComponent(id), id);
+        QCOMPARE(parallel.getComponent(id), id);
+    }
+
+    graph.insertEdge(&values[count - 1], &values[0]);
+    CsrGraph<int> cycle(graph);
+    QCOMPARE(scc(&cycle, sequential), 0);
+    QCOMPARE(sequential.getComponentCount(), 1u);
+    QCOMPARE(parallelScc(&cycle, parallel, pool), 0);
+    QCOMPARE(parallel.getComponentCount(), 1u);
+    QCOMPARE(parallel.membersEnd(0) - parallel.membersBegin(0), count);
+}
+
+void TestScc::testGraphOverload()
+{
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomGraph(graph, values, 500, 600, 3);
+    CsrGraph<int> csr(graph);
+
+    Condensation fromCsr;
+    Condensation fromGraph;
+    QCOMPARE(scc(&csr, fromCsr), 0);
+    QCOMPARE(scc(&graph, fromGraph), 0);
+    QVERIFY(fromGraph.component == fromCsr.component);
+    QVERIFY(fromGraph.edges == fromCsr.edges);
+
+    ThreadPool pool(2);
+    QCOMPARE(parallelScc(&graph, fromGraph, pool), 0);
+    checkSamePartition(fromCsr, fromGraph);
+
+    QCOMPARE(scc(static_cast<IntGraph *>(nullptr), fromGraph), -1);
+}
+
+QTEST_APPLESS_MAIN(TestScc)
+#include "tst_scc.moc"
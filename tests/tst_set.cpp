@@ -24,6 +24,8 @@ private slots:
     void testSubset();
     void testEqualSet();
     void testCustomSetFunctors();
+    void testHashedSet();
+    void testHashedSetOperations();
 };
 
 // Simple test data class
@@ -48,6 +50,14 @@ struct CompareTestData
     }
 };
 
+struct HashTestData
+{
+    size_t operator()(const TestData &v) const
+    {
+        return std::hash<int>()(v.value);
+    }
+};
+
 // Complex record class for functor testing
 class Record
 {
@@ -893,5 +903,112 @@ void TestSet::testCustomSetFunctors()
     }
 }
 
+void TestSet::testHashedSet()
+{
+    typedef Set<TestData, CompareTestData, HashTestData> HashedSet;
+    HashedSet set;
+    const int count = 500;
+    TestData *owned[count];
+
+    for (int i = 0; i < count; i++) {
+        owned[i] = new TestData(i);
+        set.insert(owned[i], true);
+    }
+    QCOMPARE(set.getSize(), count);
+
+    // Membership is by value, through the hash index
+    TestData probe(123);
+    QVERIFY(set.isMember(&probe));
+    TestData missing(count);
+    QVERIFY(!set.isMember(&missing));
+
+    // Duplicates by value are rejected
+    TestData duplicate(7);
+    set.insert(&duplicate);
+    QCOMPARE(set.getSize(), count);
+
+    // Remove the head, a middle element and the tail
+    TestData first(0), middle(250), last(count - 1);
+    QVERIFY(set.remove(&first));
+    QVERIFY(set.remove(&middle));
+    QVERIFY(set.remove(&last));
+    QVERIFY(!set.remove(&middle));
+    QCOMPARE(set.getSize(), count - 3);
+    QVERIFY(!set.isMember(&middle));
+
+    // Iteration still follows insertion order in both directions
+    QCOMPARE(set.head()->data()->value, 1);
+    QCOMPARE(set.tail()->data()->value, count - 2);
+    QVERIFY(set.head()->prev() == nullptr);
+    int expected = 1;
+    int visited = 0;
+    for (SetNode<TestData> *node = set.head(); node != nullptr; node = node->next()) {
+        if (expected == 250) {
+            expected++;
+        }
+        QCOMPARE(node->data()->value, expected++);
+        if (node->next() != nullptr) {
+            QCOMPARE(node->next()->prev(), node);
+        }
+        visited++;
+    }
+    QCOMPARE(visited, count - 3);
+
+    // A removed value can be inserted again and is found
+    TestData *again = new TestData(250);
+    set.insert(again, true);
+    QVERIFY(set.isMember(&middle));
+    QCOMPARE(set.tail()->data(), again);
+
+    // Removing released ownership, so the removed elements are ours to delete
+    QVERIFY(!set.hasOwnership(owned[0]));
+    delete owned[0];
+    delete owned[250];
+    delete owned[count - 1];
+}
+
+void TestSet::testHashedSetOperations()
+{
+    typedef Set<TestData, CompareTestData, HashTestData> HashedSet;
+    HashedSet set1;
+    HashedSet set2;
+    TestData values[10];
+    TestData copies[10];
+
+    // set1 = {0..5}, set2 = {3..9} using distinct but equal objects
+    for (int i = 0; i < 10; i++) {
+        values[i].value = i;
+        copies[i].value = i;
+    }
+    for (int i = 0; i <= 5; i++) {
+        set1.insert(&values[i]);
+    }
+    for (int i = 3; i < 10; i++) {
+        set2.insert(&copies[i]);
+    }
+
+    HashedSet unionResult;
+    HashedSet::unionSet(&unionResult, &set1, &set2);
+    QCOMPARE(unionResult.getSize(), 10);
+
+    HashedSet intersectionResult;
+    HashedSet::intersectionSet(&intersectionResult, &set1, &set2);
+    QCOMPARE(intersectionResult.getSize(), 3);
+    QVERIFY(intersectionResult.isMember(&values[4]));
+    QVERIFY(!intersectionResult.isMember(&values[2]));
+
+    HashedSet differenceResult;
+    HashedSet::differenceSet(&differenceResult, &set1, &set2);
+    QCOMPARE(differenceResult.getSize(), 3);
+    QVERIFY(differenceResult.isMember(&copies[0]));
+    QVERIFY(!differenceResult.isMember(&copies[3]));
+
+    QVERIFY(HashedSet::isSubset(&intersectionResult, &set1));
+    QVERIFY(HashedSet::isSubset(&intersectionResult, &set2));
+    QVERIFY(!HashedSet::isSubset(&set1, &set2));
+    QVERIFY(HashedSet::isEqualSet(&unionResult, &unionResult));
+    QVERIFY(!HashedSet::isEqualSet(&set1, &set2));
+}
+
 QTEST_APPLESS_MAIN(TestSet)
 #include "tst_set.moc"
@@ -0,0 +1,188 @@
+#include <QtTest/QtTest>
+#include <random>
+#include <vector>
+#include "../graph.h"
+#include "../bfs.h"
+#include "../shortestpath.h"
+#include "../bfsvertex.h"
+#include "randomgraph.h"
+
+class TestShortestPath : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Runs before each test function
+    void init();
+
+    // Runs after each test function
+    void cleanup();
+
+    // Test functions - each test is a separate function
+    void testChain();
+    void testMatchesBfs_data();
+    void testMatchesBfs();
+    void testUnreachable();
+    void testUnhashedGraph();
+};
+
+// Check that path runs from source to target along edges of the graph
+template<class G>
+static void checkPath(G &graph, List<BfsVertex<int>> &path, BfsVertex<int> *source, BfsVertex<int> *target)
+{
+    QVERIFY(path.getSize() > 0);
+    QCOMPARE(path.head()->data(), source);
+    QCOMPARE(path.tail()->data(), target);
+
+    for (ListNode<BfsVertex<int>> *node = path.head(); node->next() != nullptr; node = node->next()) {
+        QVERIFY(graph.isAdjacentGraph(node->data(), node->next()->data()));
+    }
+}
+
+void TestShortestPath::init()
+{
+    // Setup code that runs before each test
+}
+
+void TestShortestPath::cleanup()
+{
+    // Cleanup code that runs after each test
+}
+
+void TestShortestPath::testChain()
+{
+    BfsGraph graph;
+    std::vector<int> values(6);
+    std::vector<BfsVertex<int> *> vertices(6);
+
+    for (int i = 0; i < 6; i++) {
+        values[i] = i;
+        vertices[i] = new BfsVertex<int>(&values[i]);
+        graph.insertVertex(vertices[i], true);
+    }
+
+    // 0 -> 1 -> 2 -> 3 -> 4 -> 5 with a shortcut 1 -> 4
+    for (int i = 0; i < 5; i++) {
+        graph.insertEdge(vertices[i], vertices[i + 1]);
+    }
+    graph.insertEdge(vertices[1], vertices[4]);
+
+    List<BfsVertex<int>> path;
+    QCOMPARE(shortestPath(&graph, vertices[0], vertices[5], path), 0);
+    QCOMPARE(path.getSize(), 4);
+    checkPath(graph, path, vertices[0], vertices[5]);
+    QCOMPARE(path.head()->next()->next()->data(), vertices[4]);
+
+    // A path to itself is the vertex alone
+    QCOMPARE(shortestPath(&graph, vertices[2], vertices[2], path), 0);
+    QCOMPARE(path.getSize(), 1);
+    QCOMPARE(path.head()->data(), vertices[2]);
+
+    // Edges are directed
+    QCOMPARE(shortestPath(&graph, vertices[5], vertices[0], path), 1);
+    QCOMPARE(path.getSize(), 0);
+
+    // Ends are found by value and the path holds the graph's vertices
+    int five = 5;
+    BfsVertex<int> equalToFive(&five);
+    QCOMPARE(shortestPath(&graph, vertices[3], &equalToFive, path), 0);
+    checkPath(graph, path, vertices[3], vertices[5]);
+
+    int missing = 9;
+    BfsVertex<int> stranger(&missing);
+    QCOMPARE(shortestPath(&graph, vertices[0], &stranger, path), -1);
+    QCOMPARE(shortestPath(&graph, static_cast<BfsVertex<int> *>(nullptr), vertices[0], path), -1);
+}
+
+void TestShortestPath::testMatchesBfs_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("edges");
+
+    QTest::newRow("sparse") << 300 << 450;
+    QTest::newRow("medium") << 500 << 1500;
+    QTest::newRow("dense") << 200 << 3000;
+}
+
+void TestShortestPath::testMatchesBfs()
+{
+    QFETCH(int, count);
+    QFETCH(int, edges);
+
+    BfsGraph graph;
+    std::vector<int> values;
+    std::vector<BfsVertex<int> *> vertices;
+    buildRandomGraph(graph, values, vertices, count, edges, count + edges);
+
+    std::mt19937 rng(edges);
+    std::uniform_int_distribution<int> pick(0, count - 1);
+
+    for (int round = 0; round < 30; round++) {
+        BfsVertex<int> *source = vertices[pick(rng)];
+        List<BfsVertex<int>> hops;
+        QCOMPARE(bfs(&graph, source, hops), 0);
+
+        for (int pair = 0; pair < 10; pair++) {
+            BfsVertex<int> *target = vertices[pick(rng)];
+            int expected = target->getHops();
+
+            List<BfsVertex<int>> path;
+            int result = shortestPath(&graph, source, target, path);
+
+            if (expected == -1) {
+                QCOMPARE(result, 1);
+                QCOMPARE(path.getSize(), 0);
+            } else {
+                QCOMPARE(result, 0);
+                QCOMPARE(path.getSize(), expected + 1);
+                checkPath(graph, path, source, target);
+            }
+        }
+    }
+}
+
+void TestShortestPath::testUnreachable()
+{
+    // Two components, with edges only inside each
+    BfsGraph graph;
+    std::vector<int> values(40);
+    std::vector<BfsVertex<int> *> vertices(40);
+
+    for (int i = 0; i < 40; i++) {
+        values[i] = i;
+        vertices[i] = new BfsVertex<int>(&values[i]);
+        graph.insertVertex(vertices[i], true);
+    }
+    for (int i = 0; i < 40; i++) {
+        int base = i < 20 ? 0 : 20;
+        graph.insertEdge(vertices[i], vertices[base + (i + 1) % 20]);
+        graph.insertEdge(vertices[i], vertices[base + (i + 7) % 20]);
+    }
+
+    List<BfsVertex<int>> path;
+    QCOMPARE(shortestPath(&graph, vertices[3], vertices[25], path), 1);
+    QCOMPARE(path.getSize(), 0);
+    QCOMPARE(shortestPath(&graph, vertices[23], vertices[39], path), 0);
+    checkPath(graph, path, vertices[23], vertices[39]);
+}
+
+void TestShortestPath::testUnhashedGraph()
+{
+    Graph<BfsVertex<int>, CompareValue> graph;
+    std::vector<int> values;
+    std::vector<BfsVertex<int> *> vertices;
+    buildRandomGraph(graph, values, vertices, 80, 200, 17);
+
+    List<BfsVertex<int>> hops;
+    QCOMPARE(bfs(&graph, vertices[0], hops), 0);
+
+    for (BfsVertex<int> *target : vertices) {
+        int expected = target->getHops();
+        List<BfsVertex<int>> path;
+        QCOMPARE(shortestPath(&graph, vertices[0], target, path), expected == -1 ? 1 : 0);
+        QCOMPARE(path.getSize(), expected + 1);
+    }
+}
+
+QTEST_APPLESS_MAIN(TestShortestPath)
+#include "tst_shortestpath.moc"
@@ -0,0 +1,212 @@
+#include <QtTest/QtTest>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+#include "../sortedkernels.h"
+#include "../flatset.h"
+
+class TestSortedKernels : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Runs before each test function
+    void init();
+
+    // Runs after each test function
+    void cleanup();
+
+    // Test functions - each test is a separate function
+    void testEmptyInputs();
+    void testExtremeValues();
+    void testKernels_data();
+    void testKernels();
+    void testFlatSetKernels();
+};
+
+typedef std::vector<uint32_t> Values;
+
+// Sorted, duplicate free values drawn from [0, range)
+static Values randomSorted(std::mt19937& rng, size_t count, uint32_t range)
+{
+    std::uniform_int_distribution<uint32_t> pick(0, range - 1);
+    Values values;
+    for (size_t i = 0; i < count; i++) {
+        values.push_back(pick(rng));
+    }
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    return values;
+}
+
+// Every level this CPU can run
+static std::vector<SimdLevel> levels()
+{
+    std::vector<SimdLevel> result;
+    for (SimdLevel level : {SimdScalar, SimdSse42, SimdAvx2}) {
+        if (level <= detectSimdLevel()) {
+            result.push_back(level);
+        }
+    }
+    return result;
+}
+
+// Compare every kernel at every level against the standard algorithms
+static void checkKernels(const Values& a, const Values& b)
+{
+    Values intersection;
+    Values difference;
+    Values unionValues;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(intersection));
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(difference));
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(unionValues));
+
+    Values out(a.size() + b.size() + 1);
+    for (SimdLevel level : levels()) {
+        size_t n = sortedIntersect(a.data(), a.size(), b.data(), b.size(), out.data(), level);
+        QCOMPARE(Values(out.begin(), out.begin() + n), intersection);
+
+        n = sortedDifference(a.data(), a.size(), b.data(), b.size(), out.data(), level);
+        QCOMPARE(Values(out.begin(), out.begin() + n), difference);
+
+        n = sortedUnion(a.data(), a.size(), b.data(), b.size(), out.data(), level);
+        QCOMPARE(Values(out.begin(), out.begin() + n), unionValues);
+
+        QCOMPARE(sortedIntersectCount(a.data(), a.size(), b.data(), b.size(), level), intersection.size());
+
+        // Positions point back into a
+        n = sortedIntersectPositions(a.data(), a.size(), b.data(), b.size(), out.data(), level);
+        QCOMPARE(n, intersection.size());
+        for (size_t k = 0; k < n; k++) {
+            QCOMPARE(a[out[k]], intersection[k]);
+        }
+
+        n = sortedDifferencePositions(a.data(), a.size(), b.data(), b.size(), out.data(), level);
+        QCOMPARE(n, difference.size());
+        for (size_t k = 0; k < n; k++) {
+            QCOMPARE(a[out[k]], difference[k]);
+        }
+    }
+}
+
+void TestSortedKernels::init()
+{
+    // Setup code that runs before each test
+}
+
+void TestSortedKernels::cleanup()
+{
+    // Cleanup code that runs after each test
+}
+
+void TestSortedKernels::testEmptyInputs()
+{
+    Values some = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    checkKernels(Values(), Values());
+    checkKernels(some, Values());
+    checkKernels(Values(), some);
+    checkKernels(some, some);
+}
+
+void TestSortedKernels::testExtremeValues()
+{
+    // The unsigned comparisons must hold at both ends of the range
+    Values a = {0, 1, 2, 3, 4, 5, 6, 7, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFE, 0xFFFFFFFF};
+    Values b = {0, 2, 4, 6, 8, 10, 12, 14, 0x80000000, 0x80000001, 0xFFFFFFFD, 0xFFFFFFFF};
+    checkKernels(a, b);
+    checkKernels(b, a);
+}
+
+void TestSortedKernels::testKernels_data()
+{
+    QTest::addColumn<int>("sizeA");
+    QTest::addColumn<int>("sizeB");
+    QTest::addColumn<int>("range");
+
+    // Sizes around the block widths, then growing size ratios
+    QTest::newRow("3x5") << 3 << 5 << 16;
+    QTest::newRow("4x4") << 4 << 4 << 8;
+    QTest::newRow("7x9") << 7 << 9 << 20;
+    QTest::newRow("8x8") << 8 << 8 << 16;
+    QTest::newRow("17x33") << 17 << 33 << 64;
+    QTest::newRow("dense 1:1") << 1000 << 1000 << 1500;
+    QTest::newRow("sparse 1:1") << 1000 << 1000 << 100000;
+    QTest::newRow("1:4") << 250 << 1000 << 2000;
+    QTest::newRow("1:16") << 64 << 1024 << 2048;
+    QTest::newRow("1:64") << 20 << 1280 << 4096;
+    QTest::newRow("64:1") << 1280 << 20 << 4096;
+}
+
+void TestSortedKernels::testKernels()
+{
+    QFETCH(int, sizeA);
+    QFETCH(int, sizeB);
+    QFETCH(int, range);
+
+    std::mt19937 rng(sizeA * 31 + sizeB);
+    for (int round = 0; round < 50; round++) {
+        Values a = randomSorted(rng, sizeA, range);
+        Values b = randomSorted(rng, sizeB, range);
+        checkKernels(a, b);
+    }
+}
+
+void TestSortedKernels::testFlatSetKernels()
+{
+    // FlatSet<uint32_t> runs its set operations on the kernels
+    std::mt19937 rng(7);
+    Values values1 = randomSorted(rng, 500, 1000);
+    Values values2 = randomSorted(rng, 500, 1000);
+    std::shuffle(values1.begin(), values1.end(), rng);
+
+    FlatSet<uint32_t> set1;
+    FlatSet<uint32_t> set2;
+    for (uint32_t& value : values1) {
+        set1.insert(&value);
+    }
+    for (uint32_t& value : values2) {
+        set2.insert(&value);
+    }
+
+    FlatSet<uint32_t> common;
+    FlatSet<uint32_t> onlyFirst;
+    FlatSet<uint32_t> either;
+    FlatSet<uint32_t>::intersectionSet(&common, &set1, &set2);
+    FlatSet<uint32_t>::differenceSet(&onlyFirst, &set1, &set2);
+    FlatSet<uint32_t>::unionSet(&either, &set1, &set2);
+
+    Values sorted1 = values1;
+    std::sort(sorted1.begin(), sorted1.end());
+    Values expected;
+    std::set_intersection(sorted1.begin(), sorted1.end(), values2.begin(), values2.end(), std::back_inserter(expected));
+    QCOMPARE(common.getSize(), static_cast<int>(expected.size()));
+    for (uint32_t& value : expected) {
+        QVERIFY(common.isMember(&value));
+    }
+
+    // The results hold the elements of set1, not copies
+    for (auto node = onlyFirst.head(); node != nullptr; node = node->next()) {
+        QVERIFY(node->data() >= values1.data() && node->data() < values1.data() + values1.size());
+        QVERIFY(!set2.isMember(node->data()));
+    }
+    QCOMPARE(common.getSize() + onlyFirst.getSize(), set1.getSize());
+    QCOMPARE(either.getSize(), set2.getSize() + onlyFirst.getSize());
+
+    QVERIFY(FlatSet<uint32_t>::isSubset(&common, &set1));
+    QVERIFY(FlatSet<uint32_t>::isSubset(&common, &set2));
+    QVERIFY(!FlatSet<uint32_t>::isSubset(&set1, &common));
+    QVERIFY(FlatSet<uint32_t>::isEqualSet(&set1, &set1));
+
+    // Removing keeps the key copies in step
+    for (uint32_t& value : expected) {
+        QVERIFY(set1.remove(&value));
+    }
+    FlatSet<uint32_t> none;
+    FlatSet<uint32_t>::intersectionSet(&none, &set1, &set2);
+    QCOMPARE(none.getSize(), 0);
+}
+
+QTEST_APPLESS_MAIN(TestSortedKernels)
+#include "tst_sortedkernels.moc"
@@ -0,0 +1,217 @@
+#include <QtTest/QtTest>
+#include <algorithm>
+#include <vector>
+#include "../graph.h"
+#include "../csrgraph.h"
+#include "../topologicalsort.h"
+#include "../threadpool.h"
+#include "randomgraph.h"
+
+class TestTopologicalSort : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Runs before each test function
+    void init();
+
+    // Runs after each test function
+    void cleanup();
+
+    // Test functions - each test is a separate function
+    void testLevels();
+    void testCycle();
+    void testRandomDag_data();
+    void testRandomDag();
+    void testGraphOverload();
+};
+
+// Check that every sorted vertex is one level after its deepest in-neighbour,
+// and that order lists each level's vertices under that level
+static void checkLevels(const CsrGraph<int> &csr, const TopologicalOrder &result)
+{
+    uint32_t vertexCount = static_cast<uint32_t>(csr.getVertexCount());
+    QCOMPARE(static_cast<uint32_t>(result.levels.size()), vertexCount);
+
+    for (uint32_t id = 0; id < vertexCount; id++) {
+        if (result.getLevel(id) == TopologicalOrder::noLevel) {
+            continue;
+        }
+
+        uint32_t expected = 0;
+        for (const uint32_t *in = csr.incomingBegin(id); in != csr.incomingEnd(id); in++) {
+            QVERIFY(result.getLevel(*in) != TopologicalOrder::noLevel);
+            expected = std::max(expected, result.getLevel(*in) + 1);
+        }
+        QCOMPARE(result.getLevel(id), expected);
+    }
+
+    size_t listed = 0;
+    for (uint32_t level = 0; level < result.getLevelCount(); level++) {
+        QVERIFY(result.levelBegin(level) != result.levelEnd(level));
+        for (const uint32_t *id = result.levelBegin(level); id != result.levelEnd(level); id++) {
+            QCOMPARE(result.getLevel(*id), level);
+            listed++;
+        }
+    }
+    QCOMPARE(listed, result.order.size());
+}
+
+void TestTopologicalSort::init()
+{
+    // Setup code that runs before each test
+}
+
+void TestTopologicalSort::cleanup()
+{
+    // Cleanup code that runs after each test
+}
+
+void TestTopologicalSort::testLevels()
+{
+    IntGraph graph;
+    int values[6] = {0, 1, 2, 3, 4, 5};
+    for (int &value : values) {
+        graph.insertVertex(&value);
+    }
+
+    // 0 -> 1 -> 3 -> 4, 0 -> 2 -> 4, 5 alone
+    graph.insertEdge(&values[0], &values[1]);
+    graph.insertEdge(&values[1], &values[3]);
+    graph.insertEdge(&values[3], &values[4]);
+    graph.insertEdge(&values[0], &values[2]);
+    graph.insertEdge(&values[2], &values[4]);
+
+    CsrGraph<int> csr(graph);
+    ThreadPool pool(3);
+    TopologicalOrder sequential;
+    TopologicalOrder parallel;
+    QCOMPARE(topologicalSort(&csr, sequential), 0);
+    QCOMPARE(parallelTopologicalSort(&csr, parallel, pool), 0);
+
+    const uint32_t expected[6] = {0, 1, 1, 2, 3, 0};
+    for (TopologicalOrder *result : {&sequential, &parallel}) {
+        QVERIFY(result->isComplete());
+        QCOMPARE(result->getLevelCount(), 4u);
+        for (uint32_t id = 0; id < 6; id++) {
+            QCOMPARE(result->getLevel(id), expected[id]);
+        }
+        QCOMPARE(result->levelEnd(0) - result->levelBegin(0), 2);
+        checkLevels(csr, *result);
+    }
+
+    // An empty graph sorts to nothing
+    IntGraph empty;
+    CsrGraph<int> emptyCsr(empty);
+    QCOMPARE(parallelTopologicalSort(&emptyCsr, parallel, pool), 0);
+    QCOMPARE(parallel.getLevelCount(), 0u);
+    QVERIFY(parallel.order.empty());
+
+    QCOMPARE(topologicalSort(static_cast<const CsrGraph<int> *>(nullptr), sequential), -1);
+}
+
+void TestTopologicalSort::testCycle()
+{
+    IntGraph graph;
+    int values[6] = {0, 1, 2, 3, 4, 5};
+    for (int &value : values) {
+        graph.insertVertex(&value);
+    }
+
+    // 0 -> 1 -> 2 -> 3 -> 1 is a cycle that 4 hangs off; 5 has a self loop
+    graph.insertEdge(&values[0], &values[1]);
+    graph.insertEdge(&values[1], &values[2]);
+    graph.insertEdge(&values[2], &values[3]);
+    graph.insertEdge(&values[3], &values[1]);
+    graph.insertEdge(&values[3], &values[4]);
+    graph.insertEdge(&values[5], &values[5]);
+
+    CsrGraph<int> csr(graph);
+    ThreadPool pool(2);
+    TopologicalOrder sequential;
+    TopologicalOrder parallel;
+    QCOMPARE(topologicalSort(&csr, sequential), 1);
+    QCOMPARE(parallelTopologicalSort(&csr, parallel, pool), 1);
+
+    for (TopologicalOrder *result : {&sequential, &parallel}) {
+        QVERIFY(!result->isComplete());
+        QCOMPARE(result->order.size(), size_t(1));
+        QCOMPARE(result->getLevel(0), 0u);
+        for (uint32_t id = 1; id < 6; id++) {
+            QCOMPARE(result->getLevel(id), TopologicalOrder::noLevel);
+        }
+        checkLevels(csr, *result);
+    }
+}
+
+void TestTopologicalSort::testRandomDag_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("edges");
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("sparse, 1 thread") << 2000 << 3000 << 1;
+    QTest::newRow("sparse, 4 threads") << 2000 << 3000 << 4;
+    QTest::newRow("dense, 2 threads") << 1000 << 20000 << 2;
+    QTest::newRow("large, 3 threads") << 50000 << 200000 << 3;
+}
+
+void TestTopologicalSort::testRandomDag()
+{
+    QFETCH(int, count);
+    QFETCH(int, edges);
+    QFETCH(int, threads);
+
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomDag(graph, values, count, edges, count + edges);
+    CsrGraph<int> csr(graph);
+
+    TopologicalOrder sequential;
+    QCOMPARE(topologicalSort(&csr, sequential), 0);
+    QVERIFY(sequential.isComplete());
+    checkLevels(csr, sequential);
+
+    ThreadPool pool(threads);
+    TopologicalOrder parallel;
+    QCOMPARE(parallelTopologicalSort(&csr, parallel, pool), 0);
+    QVERIFY(parallel.isComplete());
+    QVERIFY(parallel.levels == sequential.levels);
+    QVERIFY(parallel.levelOffsets == sequential.levelOffsets);
+    checkLevels(csr, parallel);
+
+    // An edge back from the deepest vertex to one of its in-neighbours
+    // closes a cycle, which is detected while the vertices before it sort
+    uint32_t deepest = sequential.order.back();
+    uint32_t parent = *csr.incomingBegin(deepest);
+    graph.insertEdge(csr.vertex(deepest), csr.vertex(parent));
+    CsrGraph<int> cyclic(graph);
+    QCOMPARE(parallelTopologicalSort(&cyclic, parallel, pool), 1);
+    QCOMPARE(topologicalSort(&cyclic, sequential), 1);
+    QCOMPARE(parallel.getLevel(deepest), TopologicalOrder::noLevel);
+    QVERIFY(parallel.levels == sequential.levels);
+    checkLevels(cyclic, parallel);
+}
+
+void TestTopologicalSort::testGraphOverload()
+{
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomDag(graph, values, 300, 900, 5);
+    CsrGraph<int> csr(graph);
+
+    TopologicalOrder fromCsr;
+    TopologicalOrder fromGraph;
+    QCOMPARE(topologicalSort(&csr, fromCsr), 0);
+    QCOMPARE(topologicalSort(&graph, fromGraph), 0);
+    QVERIFY(fromGraph.order == fromCsr.order);
+
+    ThreadPool pool(2);
+    QCOMPARE(parallelTopologicalSort(&graph, fromGraph, pool), 0);
+    QVERIFY(fromGraph.levels == fromCsr.levels);
+
+    QCOMPARE(topologicalSort(static_cast<IntGraph *>(nullptr), fromGraph), -1);
+}
+
+QTEST_APPLESS_MAIN(TestTopologicalSort)
+#include "tst_topologicalsort.moc"
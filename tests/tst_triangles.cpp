@@ -0,0 +1,224 @@
+#include <QtTest/QtTest>
+#include <vector>
+#include "../graph.h"
+#include "../csrgraph.h"
+#include "../triangles.h"
+#include "../threadpool.h"
+#include "randomgraph.h"
+
+class TestTriangles : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // Runs before each test function
+    void init();
+
+    // Runs after each test function
+    void cleanup();
+
+    // Test functions - each test is a separate function
+    void testCompleteGraph();
+    void testDirectionsAndSelfLoops();
+    void testMatchesAdjacencyChecks_data();
+    void testMatchesAdjacencyChecks();
+    void testThreadCountIndependent();
+    void testEmptyGraph();
+    void testGraphOverload();
+};
+
+void TestTriangles::init()
+{
+    // Setup code that runs before each test
+}
+
+void TestTriangles::cleanup()
+{
+    // Cleanup code that runs after each test
+}
+
+void TestTriangles::testCompleteGraph()
+{
+    // Every triple of K5 is a triangle, and every vertex is in 6 of the 10
+    IntGraph graph;
+    int values[5] = {0, 1, 2, 3, 4};
+    for (int &value : values) {
+        graph.insertVertex(&value);
+    }
+    for (int i = 0; i < 5; i++) {
+        for (int j = i + 1; j < 5; j++) {
+            graph.insertEdge(&values[i], &values[j]);
+        }
+    }
+
+    CsrGraph<int> csr(graph);
+    ThreadPool pool(2);
+    Triangles triangles;
+    QCOMPARE(countTriangles(&csr, triangles, pool), 0);
+    QCOMPARE(triangles.getTriangleCount(), uint64_t(10));
+    for (uint32_t id = 0; id < 5; id++) {
+        QCOMPARE(triangles.getTriangles(id), uint64_t(6));
+        QCOMPARE(triangles.getClustering(id), 1.0);
+    }
+    QCOMPARE(triangles.getAverageClustering(), 1.0);
+}
+
+void TestTriangles::testDirectionsAndSelfLoops()
+{
+    IntGraph graph;
+    int values[5] = {0, 1, 2, 3, 4};
+    for (int &value : values) {
+        graph.insertVertex(&value);
+    }
+
+    // One triangle 0-1-2 with edges both ways and in either direction, a
+    // self-loop on 0, and 3 hanging off 0; 4 is alone
+    graph.insertEdge(&values[0], &values[1]);
+    graph.insertEdge(&values[1], &values[0]);
+    graph.insertEdge(&values[2], &values[1]);
+    graph.insertEdge(&values[0], &values[2]);
+    graph.insertEdge(&values[0], &values[0]);
+    graph.insertEdge(&values[3], &values[0]);
+
+    CsrGraph<int> csr(graph);
+    ThreadPool pool(3);
+    Triangles triangles;
+    QCOMPARE(countTriangles(&csr, triangles, pool), 0);
+    QCOMPARE(triangles.getTriangleCount(), uint64_t(1));
+
+    const uint64_t counts[5] = {1, 1, 1, 0, 0};
+    for (uint32_t id = 0; id < 5; id++) {
+        QCOMPARE(triangles.getTriangles(id), counts[id]);
+    }
+
+    // 0 has neighbours 1, 2 and 3, of whose 3 pairs only 1-2 is joined
+    QCOMPARE(triangles.getClustering(0), 1.0 / 3);
+    QCOMPARE(triangles.getClustering(1), 1.0);
+    QCOMPARE(triangles.getClustering(3), 0.0);
+    QCOMPARE(triangles.getClustering(4), 0.0);
+}
+
+void TestTriangles::testMatchesAdjacencyChecks_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("edges");
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("sparse") << 80 << 200 << 2;
+    QTest::newRow("dense") << 60 << 1500 << 3;
+    QTest::newRow("single thread") << 70 << 700 << 1;
+}
+
+void TestTriangles::testMatchesAdjacencyChecks()
+{
+    QFETCH(int, count);
+    QFETCH(int, edges);
+    QFETCH(int, threads);
+
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomGraph(graph, values, count, edges, count + edges);
+    CsrGraph<int> csr(graph);
+
+    // The O(V^3) way, with isAdjacentGraph on every pair and triple
+    auto joined = [&](int a, int b) {
+        return graph.isAdjacentGraph(&values[a], &values[b]) || graph.isAdjacentGraph(&values[b], &values[a]);
+    };
+    std::vector<uint64_t> expected(count, 0);
+    std::vector<int> degree(count, 0);
+    uint64_t expectedTotal = 0;
+    for (int a = 0; a < count; a++) {
+        for (int b = a + 1; b < count; b++) {
+            if (!joined(a, b)) {
+                continue;
+            }
+            degree[a]++;
+            degree[b]++;
+            for (int c = b + 1; c < count; c++) {
+                if (joined(a, c) && joined(b, c)) {
+                    expected[a]++;
+                    expected[b]++;
+                    expected[c]++;
+                    expectedTotal++;
+                }
+            }
+        }
+    }
+
+    ThreadPool pool(threads);
+    Triangles triangles;
+    QCOMPARE(countTriangles(&csr, triangles, pool), 0);
+    QCOMPARE(triangles.getTriangleCount(), expectedTotal);
+
+    for (int value = 0; value < count; value++) {
+        uint32_t id = csr.idOf(&values[value]);
+        QCOMPARE(triangles.getTriangles(id), expected[value]);
+
+        double pairs = degree[value] * (degree[value] - 1) / 2.0;
+        QCOMPARE(triangles.getClustering(id), pairs == 0 ? 0.0 : expected[value] / pairs);
+    }
+}
+
+void TestTriangles::testThreadCountIndependent()
+{
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomGraph(graph, values, 20000, 200000, 5);
+    CsrGraph<int> csr(graph);
+
+    ThreadPool single(1);
+    Triangles expected;
+    QCOMPARE(countTriangles(&csr, expected, single), 0);
+    QVERIFY(expected.getTriangleCount() > 0);
+
+    for (int threads : {2, 4}) {
+        ThreadPool pool(threads);
+        Triangles triangles;
+        QCOMPARE(countTriangles(&csr, triangles, pool), 0);
+        QCOMPARE(triangles.getTriangleCount(), expected.getTriangleCount());
+        QVERIFY(triangles.counts == expected.counts);
+        QVERIFY(triangles.clustering == expected.clustering);
+    }
+
+    // Each triangle is counted at each of its three vertices
+    uint64_t sum = 0;
+    for (uint64_t count : expected.counts) {
+        sum += count;
+    }
+    QCOMPARE(sum, 3 * expected.getTriangleCount());
+}
+
+void TestTriangles::testEmptyGraph()
+{
+    IntGraph graph;
+    CsrGraph<int> csr(graph);
+    ThreadPool pool(2);
+    Triangles triangles;
+    QCOMPARE(countTriangles(&csr, triangles, pool), 0);
+    QCOMPARE(triangles.getTriangleCount(), uint64_t(0));
+    QVERIFY(triangles.counts.empty());
+    QCOMPARE(triangles.getAverageClustering(), 0.0);
+
+    QCOMPARE(countTriangles(static_cast<const CsrGraph<int> *>(nullptr), triangles, pool), -1);
+}
+
+void TestTriangles::testGraphOverload()
+{
+    IntGraph graph;
+    std::vector<int> values;
+    buildRandomGraph(graph, values, 400, 3000, 9);
+    CsrGraph<int> csr(graph);
+    ThreadPool pool(2);
+
+    Triangles fromCsr;
+    Triangles fromGraph;
+    QCOMPARE(countTriangles(&csr, fromCsr, pool), 0);
+    QCOMPARE(countTriangles(&graph, fromGraph, pool), 0);
+    QCOMPARE(fromGraph.getTriangleCount(), fromCsr.getTriangleCount());
+    QVERIFY(fromGraph.counts == fromCsr.counts);
+
+    QCOMPARE(countTriangles(static_cast<IntGraph *>(nullptr), fromGraph, pool), -1);
+}
+
+QTEST_APPLESS_MAIN(TestTriangles)
+#include "tst_triangles.moc"
@@ -0,0 +1,6 @@
+#include "threadpool.h"
+
+// This file is mostly empty because ThreadPool is implemented
+// inline in the header file.
+// Including this file in the project for consistency with
+// the project structure.
@@ -0,0 +1,272 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of worker threads that run one task together
+ *
+ * run() hands the same task to every thread and returns when all of them
+ * are done. The calling thread takes part as thread 0, so a pool of N
+ * threads starts N - 1 workers, and a pool of one thread runs the task
+ * inline. The workers are started once and sleep between tasks, so a pool
+ * can be reused for many parallel algorithms without paying for thread
+ * creation each time.
+ *
+ * Inside a task, barrier() waits until every thread of the pool has
+ * reached it, which is how level-synchronous algorithms separate their
+ * phases. Everything written before a barrier is visible to all threads
+ * after it.
+ */
+class ThreadPool
+{
+private:
+    std::vector<std::thread> workers;
+    std::function<void(unsigned)> task;
+
+    std::mutex mutex;
+    std::condition_variable wake;      // Workers wait here for the next task
+    std::condition_variable finished;  // run() waits here for the workers
+    unsigned generation;               // Number of tasks started so far
+    unsigned running;                  // Workers still running the current task
+    bool stopping;
+
+    std::atomic<unsigned> arrived;            // Threads waiting at the barrier
+    std::atomic<unsigned> barrierGeneration;  // Number of barriers passed so far
+    std::mutex barrierMutex;
+    std::condition_variable barrierWake;
+
+    // Short barrier waits are common between BFS levels, so spin a little
+    // before going to sleep
+    static const int barrierSpins = 2048;
+
+    void work(unsigned thread) {
+        unsigned seen = 0;
+
+        while (true) {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->wake.wait(lock, [&] { return this->stopping || this->generation != seen; });
+            if (this->stopping) {
+                return;
+            }
+            seen = this->generation;
+            lock.unlock();
+
+            this->task(thread);
+
+            lock.lock();
+            if (--this->running == 0) {
+                this->finished.notify_one();
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Start the workers
+     * @param threadCount Number of threads including the caller, or 0 for
+     * one per hardware thread
+     */
+    explicit ThreadPool(unsigned threadCount = 0)
+        : generation(0), running(0), stopping(false), arrived(0), barrierGeneration(0) {
+        if (threadCount == 0) {
+            threadCount = std::thread::hardware_concurrency();
+        }
+        if (threadCount == 0) {
+            threadCount = 1;
+        }
+
+        for (unsigned thread = 1; thread < threadCount; thread++) {
+            this->workers.emplace_back(&ThreadPool::work, this, thread);
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->stopping = true;
+        }
+        this->wake.notify_all();
+
+        for (std::thread& worker : this->workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned getThreadCount() const {
+        return static_cast<unsigned>(this->workers.size()) + 1;
+    }
+
+    /**
+     * @brief Run task(thread) on every thread, thread being 0 .. count - 1
+     *
+     * Returns once every thread has finished the task. Tasks must not call
+     * run() on the same pool.
+     */
+    void run(const std::function<void(unsigned)>& task) {
+        if (this->workers.empty()) {
+            task(0);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->task = task;
+            this->running = static_cast<unsigned>(this->workers.size());
+            this->generation++;
+        }
+        this->wake.notify_all();
+
+        task(0);
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->finished.wait(lock, [&] { return this->running == 0; });
+        this->task = nullptr;
+    }
+
+    /**
+     * @brief Wait until every thread of the running task gets here
+     *
+     * Must be called by all threads the same number of times.
+     */
+    void barrier() {
+        unsigned count = this->getThreadCount();
+        if (count == 1) {
+            return;
+        }
+
+        unsigned current = this->barrierGeneration.load(std::memory_order_acquire);
+
+        // The last thread to arrive releases the others
+        if (this->arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+            this->arrived.store(0, std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> lock(this->barrierMutex);
+                this->barrierGeneration.fetch_add(1, std::memory_order_acq_rel);
+            }
+            this->barrierWake.notify_all();
+            return;
+        }
+
+        for (int spin = 0; spin < barrierSpins; spin++) {
+            if (this->barrierGeneration.load(std::memory_order_acquire) != current) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+
+        std::unique_lock<std::mutex> lock(this->barrierMutex);
+        this->barrierWake.wait(lock, [&] {
+            return this->barrierGeneration.load(std::memory_order_acquire) != current;
+        });
+    }
+};
+
+// Indices are handed out to the threads in chunks of this many, unless an
+// algorithm asks for another size
+static const size_t parallelChunk = 64;
+
+// Run visit(i) for every i in [0, count) that the calling thread claims
+// from cursor, a chunk at a time, until none are left. For use inside a
+// task of a pool; a cursor reused for another loop must be reset past a
+// barrier that every thread has passed after its last claim.
+template<typename Visit>
+void forEachClaimed(std::atomic<size_t>& cursor, size_t count, size_t chunk, Visit visit) {
+    while (true) {
+        size_t begin = cursor.fetch_add(chunk, std::memory_order_relaxed);
+        if (begin >= count) {
+            break;
+        }
+        size_t end = std::min(begin + chunk, count);
+
+        for (size_t i = begin; i < end; i++) {
+            visit(i);
+        }
+    }
+}
+
+// Run visit(thread, i) for every i in [0, count) on the threads of the
+// pool, which claim the indices in chunks
+template<typename Visit>
+void parallelFor(ThreadPool& pool, size_t count, size_t chunk, Visit visit) {
+    std::atomic<size_t> cursor(0);
+
+    pool.run([&](unsigned thread) {
+        forEachClaimed(cursor, count, chunk, [&](size_t i) {
+            visit(thread, i);
+        });
+    });
+}
+
+// Level-synchronous expansion of a frontier of vertex IDs, shared by the
+// parallel BFS-like algorithms. frontier holds the first level and is left
+// empty; capacity bounds the size of any level.
+//
+// Every level, the threads claim chunks of the frontier from a shared
+// cursor and call expand(vertex, level, discovered) for each vertex, which
+// appends the vertices it puts in the next level to discovered, a list
+// local to the thread. After a barrier the threads copy their lists into
+// the next frontier at offsets given by a prefix sum of the list sizes, so
+// merging needs no lock, and a second barrier ends the level. Expansion
+// stops at the first level that discovers nothing.
+template<typename Expand>
+void expandFrontier(ThreadPool& pool, std::vector<uint32_t>& frontier, size_t capacity, Expand expand) {
+    size_t frontierSize = frontier.size();
+    frontier.resize(std::max(capacity, frontierSize));
+    std::vector<uint32_t> next(frontier.size());
+    std::vector<size_t> discovered(pool.getThreadCount());
+    std::atomic<size_t> cursor(0);
+
+    pool.run([&](unsigned thread) {
+        std::vector<uint32_t> local;
+        uint32_t* current = frontier.data();
+        uint32_t* following = next.data();
+        size_t currentSize = frontierSize;
+
+        for (uint32_t level = 0; currentSize > 0; level++) {
+            forEachClaimed(cursor, currentSize, parallelChunk, [&](size_t i) {
+                expand(current[i], level, local);
+            });
+
+            discovered[thread] = local.size();
+            pool.barrier();
+
+            size_t offset = 0;
+            size_t total = 0;
+            for (unsigned t = 0; t < discovered.size(); t++) {
+                if (t < thread) {
+                    offset += discovered[t];
+                }
+                total += discovered[t];
+            }
+
+            std::copy(local.begin(), local.end(), following + offset);
+            local.clear();
+
+            // Nobody takes from the cursor again before the next barrier
+            if (thread == 0) {
+                cursor.store(0, std::memory_order_relaxed);
+            }
+            pool.barrier();
+
+            std::swap(current, following);
+            currentSize = total;
+        }
+    });
+
+    frontier.clear();
+}
+
+#endif // THREADPOOL_H
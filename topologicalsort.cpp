@@ -0,0 +1,6 @@
+#include "topologicalsort.h"
+
+// This file is mostly empty because template implementations
+// must be in the header file.
+// Including this file in the project for consistency with
+// the project structure.
@@ -0,0 +1,193 @@
+#ifndef TOPOLOGICALSORT_H
+#define TOPOLOGICALSORT_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "graph.h"
+#include "csrgraph.h"
+#include "threadpool.h"
+
+/**
+ * @struct TopologicalOrder
+ * @brief Vertex IDs of a CsrGraph in topological order, grouped by level
+ *
+ * Level 0 holds the vertices without in-edges, and level k + 1 the vertices
+ * whose last in-neighbour is in level k, so the vertices of one level have
+ * no edges between them and can be processed concurrently once the levels
+ * before them are done. order lists the levels one after the other;
+ * levelBegin(k) .. levelEnd(k) is level k.
+ *
+ * Vertices on a cycle, or reachable from one, get no level: getLevel
+ * returns noLevel for them and they are left out of order.
+ */
+struct TopologicalOrder
+{
+    static constexpr uint32_t noLevel = UINT32_MAX;
+
+    std::vector<uint32_t> order;         // Vertex IDs, level by level
+    std::vector<uint32_t> levels;        // Level of each vertex ID
+    std::vector<uint32_t> levelOffsets;  // Start of each level in order, plus the end
+
+    uint32_t getLevelCount() const {
+        return this->levelOffsets.empty() ? 0 : static_cast<uint32_t>(this->levelOffsets.size() - 1);
+    }
+
+    uint32_t getLevel(uint32_t id) const {
+        return this->levels[id];
+    }
+
+    const uint32_t* levelBegin(uint32_t level) const {
+        return this->order.data() + this->levelOffsets[level];
+    }
+
+    const uint32_t* levelEnd(uint32_t level) const {
+        return this->order.data() + this->levelOffsets[level + 1];
+    }
+
+    // True when every vertex got a level, i.e. the graph has no cycle
+    bool isComplete() const {
+        return this->order.size() == this->levels.size();
+    }
+};
+
+// Kahn's topological sort, one level at a time. Returns 0 when the graph is
+// acyclic, and 1 when it has a cycle, in which case order holds only the
+// vertices that could be sorted.
+template<typename T>
+int topologicalSort(const CsrGraph<T>* graph, TopologicalOrder& result) {
+    if (!graph) {
+        return -1;
+    }
+
+    uint32_t vertexCount = static_cast<uint32_t>(graph->getVertexCount());
+    std::vector<uint32_t> inCount(vertexCount);
+
+    result.order.clear();
+    result.order.reserve(vertexCount);
+    result.levels.assign(vertexCount, TopologicalOrder::noLevel);
+    result.levelOffsets.assign(1, 0);
+
+    for (uint32_t id = 0; id < vertexCount; id++) {
+        inCount[id] = graph->inDegree(id);
+        if (inCount[id] == 0) {
+            result.levels[id] = 0;
+            result.order.push_back(id);
+        }
+    }
+
+    for (uint32_t level = 0; result.order.size() > result.levelOffsets.back(); level++) {
+        size_t begin = result.levelOffsets.back();
+        size_t end = result.order.size();
+        result.levelOffsets.push_back(static_cast<uint32_t>(end));
+
+        for (size_t i = begin; i < end; i++) {
+            uint32_t vertex = result.order[i];
+
+            for (const uint32_t* adj = graph->adjacentBegin(vertex); adj != graph->adjacentEnd(vertex); adj++) {
+                if (--inCount[*adj] == 0) {
+                    result.levels[*adj] = level + 1;
+                    result.order.push_back(*adj);
+                }
+            }
+        }
+    }
+
+    return result.isComplete() ? 0 : 1;
+}
+
+// Kahn's topological sort on a thread pool, giving the same levels as
+// topologicalSort; the order within a level can differ.
+//
+// The levels are expanded by expandFrontier, starting from the vertices
+// without in-edges. The threads decrement the in-edge counts of the
+// neighbours atomically, and the thread that takes a count to zero puts
+// that vertex in the next level. Each vertex records its level when it is
+// expanded, and the sorted vertices are grouped by level at the end, in
+// ID order within a level.
+template<typename T>
+int parallelTopologicalSort(const CsrGraph<T>* graph, TopologicalOrder& result, ThreadPool& pool) {
+    if (!graph) {
+        return -1;
+    }
+
+    uint32_t vertexCount = static_cast<uint32_t>(graph->getVertexCount());
+    std::unique_ptr<std::atomic<uint32_t>[]> inCount(new std::atomic<uint32_t>[vertexCount]);
+    std::vector<uint32_t> frontier;
+
+    result.levels.assign(vertexCount, TopologicalOrder::noLevel);
+
+    for (uint32_t id = 0; id < vertexCount; id++) {
+        uint32_t count = graph->inDegree(id);
+        inCount[id].store(count, std::memory_order_relaxed);
+        if (count == 0) {
+            frontier.push_back(id);
+        }
+    }
+
+    // Every vertex is in at most one level, and expanded by one thread
+    expandFrontier(pool, frontier, vertexCount, [&](uint32_t vertex, uint32_t level, std::vector<uint32_t>& discovered) {
+        result.levels[vertex] = level;
+
+        for (const uint32_t* adj = graph->adjacentBegin(vertex); adj != graph->adjacentEnd(vertex); adj++) {
+            if (inCount[*adj].fetch_sub(1, std::memory_order_relaxed) == 1) {
+                discovered.push_back(*adj);
+            }
+        }
+    });
+
+    // Counting sort of the sorted vertices by level
+    result.levelOffsets.assign(1, 0);
+    for (uint32_t id = 0; id < vertexCount; id++) {
+        uint32_t level = result.levels[id];
+        if (level == TopologicalOrder::noLevel) {
+            continue;
+        }
+        if (level + 2 > result.levelOffsets.size()) {
+            result.levelOffsets.resize(level + 2, 0);
+        }
+        result.levelOffsets[level + 1]++;
+    }
+    for (size_t level = 1; level < result.levelOffsets.size(); level++) {
+        result.levelOffsets[level] += result.levelOffsets[level - 1];
+    }
+
+    result.order.resize(result.levelOffsets.back());
+    std::vector<uint32_t> fill(result.levelOffsets.begin(), result.levelOffsets.end() - 1);
+    for (uint32_t id = 0; id < vertexCount; id++) {
+        uint32_t level = result.levels[id];
+        if (level != TopologicalOrder::noLevel) {
+            result.order[fill[level]++] = id;
+        }
+    }
+
+    return result.isComplete() ? 0 : 1;
+}
+
+// Topological sort of a Graph. The list-based graph is snapshot to a
+// CsrGraph first, so vertex ID i is the i-th vertex of the graph's
+// adjacency lists, as in CsrGraph.
+template<typename T, typename Compare, typename Hash, typename AdjacentSet>
+int topologicalSort(Graph<T, Compare, Hash, AdjacentSet>* graph, TopologicalOrder& result) {
+    if (!graph) {
+        return -1;
+    }
+
+    CsrGraph<T> snapshot(*graph);
+    return topologicalSort(&snapshot, result);
+}
+
+template<typename T, typename Compare, typename Hash, typename AdjacentSet>
+int parallelTopologicalSort(Graph<T, Compare, Hash, AdjacentSet>* graph, TopologicalOrder& result, ThreadPool& pool) {
+    if (!graph) {
+        return -1;
+    }
+
+    CsrGraph<T> snapshot(*graph);
+    return parallelTopologicalSort(&snapshot, result, pool);
+}
+
+#endif // TOPOLOGICALSORT_H
@@ -0,0 +1,6 @@
+#include "traversalstate.h"
+
+// This file is mostly empty because the state structs
+// are defined in the header file.
+// Including this file in the project for consistency with
+// the project structure.
@@ -0,0 +1,129 @@
+#ifndef TRAVERSALSTATE_H
+#define TRAVERSALSTATE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "bfsvertex.h"
+
+/**
+ * @struct BfsState
+ * @brief Visitation state of a breadth-first search, indexed by vertex ID
+ *
+ * Holds what bfs would otherwise write into BfsVertex objects, so the
+ * vertices of a CsrGraph can be of any type and several searches can run
+ * on the same graph at once, each with its own state.
+ *
+ * Every mark carries the epoch of the search that wrote it, and reset()
+ * starts a new epoch instead of clearing the marks, so a vertex whose mark
+ * is from an older search counts as not reached. Reusing one state for
+ * many searches therefore costs time in proportion to the part of the
+ * graph each search reaches, not to the size of the graph.
+ */
+struct BfsState
+{
+    // Hops of a vertex, valid when epoch is the current one
+    struct Mark {
+        uint32_t epoch;
+        int hops;
+    };
+
+    std::vector<Mark> marks;
+    std::vector<uint32_t> reached; // IDs of the reached vertices in discovery order
+    uint32_t epoch;                // Epoch of the current search, never 0
+
+    BfsState() : epoch(0) {
+    }
+
+    // Start a search over vertexCount vertices with every vertex unreached
+    void reset(uint32_t vertexCount) {
+        if (this->marks.size() != vertexCount) {
+            this->marks.assign(vertexCount, Mark{0, -1});
+            this->epoch = 0;
+        }
+
+        // Clear the marks only when the counter wraps around
+        if (++this->epoch == 0) {
+            std::fill(this->marks.begin(), this->marks.end(), Mark{0, -1});
+            this->epoch = 1;
+        }
+
+        this->reached.clear();
+    }
+
+    bool isReached(uint32_t id) const {
+        return this->marks[id].epoch == this->epoch;
+    }
+
+    void reach(uint32_t id, int hops) {
+        this->marks[id].epoch = this->epoch;
+        this->marks[id].hops = hops;
+        this->reached.push_back(id);
+    }
+
+    // Edges from the start to a vertex, -1 when it was not reached
+    int getHops(uint32_t id) const {
+        return this->isReached(id) ? this->marks[id].hops : -1;
+    }
+
+    // The color bfs would leave on the vertex
+    VertexColor getColor(uint32_t id) const {
+        return this->isReached(id) ? black : white;
+    }
+};
+
+/**
+ * @struct DfsState
+ * @brief Visitation state of a depth-first search, indexed by vertex ID
+ *
+ * finished lists the vertices in the order the search finished them, so
+ * read backwards it is the order dfs puts in its list (a topological order
+ * for acyclic graphs). stack is scratch space kept to reuse its allocation.
+ *
+ * Colors are epoch-stamped like the marks of BfsState: a vertex whose
+ * stamp is from an older search is white.
+ */
+struct DfsState
+{
+    struct Mark {
+        uint32_t epoch;
+        VertexColor color;
+    };
+
+    std::vector<Mark> marks;
+    std::vector<uint32_t> finished;
+    std::vector<std::pair<uint32_t, const uint32_t*>> stack;
+    uint32_t epoch;  // Epoch of the current search, never 0
+
+    DfsState() : epoch(0) {
+    }
+
+    // Start a search over vertexCount vertices with every vertex white
+    void reset(uint32_t vertexCount) {
+        if (this->marks.size() != vertexCount) {
+            this->marks.assign(vertexCount, Mark{0, white});
+            this->epoch = 0;
+        }
+
+        if (++this->epoch == 0) {
+            std::fill(this->marks.begin(), this->marks.end(), Mark{0, white});
+            this->epoch = 1;
+        }
+
+        this->finished.clear();
+        this->stack.clear();
+    }
+
+    VertexColor getColor(uint32_t id) const {
+        return this->marks[id].epoch == this->epoch ? this->marks[id].color : white;
+    }
+
+    void setColor(uint32_t id, VertexColor color) {
+        this->marks[id].epoch = this->epoch;
+        this->marks[id].color = color;
+    }
+};
+
+#endif // TRAVERSALSTATE_H
@@ -0,0 +1,192 @@
+#ifndef TRIANGLES_H
+#define TRIANGLES_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "graph.h"
+#include "csrgraph.h"
+#include "sortedkernels.h"
+#include "threadpool.h"
+
+/**
+ * @struct Triangles
+ * @brief Triangle counts and local clustering coefficients, indexed by vertex ID
+ *
+ * Edge directions are ignored and self-loops dropped, so u, v and w form a
+ * triangle when each pair is joined by an edge either way. counts[v] is
+ * the number of triangles through v, and clustering[v] the fraction of the
+ * pairs of v's neighbours that are joined, 0 for fewer than two neighbours.
+ */
+struct Triangles
+{
+    std::vector<uint64_t> counts;
+    std::vector<double> clustering;
+    uint64_t triangleCount;
+
+    Triangles() : triangleCount(0) {
+    }
+
+    // Number of distinct triangles in the graph
+    uint64_t getTriangleCount() const {
+        return this->triangleCount;
+    }
+
+    uint64_t getTriangles(uint32_t id) const {
+        return this->counts[id];
+    }
+
+    double getClustering(uint32_t id) const {
+        return this->clustering[id];
+    }
+
+    // Mean of the local clustering coefficients, 0 for an empty graph
+    double getAverageClustering() const {
+        double sum = 0;
+        for (double coefficient : this->clustering) {
+            sum += coefficient;
+        }
+        return this->clustering.empty() ? 0 : sum / this->clustering.size();
+    }
+};
+
+// Triangle counts and clustering coefficients on a thread pool.
+//
+// The snapshot is first turned into sorted undirected neighbour lists,
+// merging each vertex's out-edges and in-edges with sortedUnion straight
+// into a slot sized for both, so every list is merged once. Every edge is
+// then oriented from the endpoint of lower degree to the one of higher
+// degree (ties broken by ID) and only the forward half of each list is
+// kept. A triangle has one vertex that comes first in this order, so it
+// is found exactly once, as the common forward neighbours of that vertex
+// and of one of its forward neighbours, by sortedIntersect. Orienting by
+// degree keeps the lists of the hubs short, which bounds the work by
+// O(E^1.5) instead of the sum of the squared degrees.
+//
+// Triangles are added to one array of relaxed atomic counters, so memory
+// stays O(V) however many threads run. A vertex's own count and each
+// edge's are summed locally and added once; only the third vertex of each
+// triangle takes an atomic add of its own.
+template<typename T>
+int countTriangles(const CsrGraph<T>* graph, Triangles& triangles, ThreadPool& pool) {
+    if (!graph) {
+        return -1;
+    }
+
+    uint32_t vertexCount = static_cast<uint32_t>(graph->getVertexCount());
+    unsigned threadCount = pool.getThreadCount();
+
+    // Run visit(thread, id) for every vertex ID on the pool
+    auto forEachVertex = [&](auto visit) {
+        parallelFor(pool, vertexCount, parallelChunk, [&](unsigned thread, size_t id) {
+            visit(thread, static_cast<uint32_t>(id));
+        });
+    };
+
+    // Undirected neighbour lists in CSR form. List id starts at offsets[id]
+    // with room for its out- and in-degree, and holds degree[id] entries:
+    // the sorted union of both without id itself.
+    std::vector<size_t> offsets(vertexCount + 1, 0);
+    for (uint32_t id = 0; id < vertexCount; id++) {
+        offsets[id + 1] = offsets[id] + graph->degree(id) + graph->inDegree(id);
+    }
+
+    std::vector<uint32_t> neighbours(offsets[vertexCount]);
+    std::vector<uint32_t> degree(vertexCount);
+    std::vector<std::vector<uint32_t>> sorted(threadCount);
+    forEachVertex([&](unsigned thread, uint32_t id) {
+        std::vector<uint32_t>& out = sorted[thread];
+        out.assign(graph->adjacentBegin(id), graph->adjacentEnd(id));
+        std::sort(out.begin(), out.end());
+
+        uint32_t* all = neighbours.data() + offsets[id];
+        size_t count = sortedUnion(out.data(), out.size(), graph->incomingBegin(id), graph->inDegree(id), all);
+        degree[id] = static_cast<uint32_t>(std::remove(all, all + count, id) - all);
+    });
+
+    // Keep only the neighbours that come later in (degree, ID) order, at the
+    // front of each list, which stays sorted
+    std::vector<uint32_t> forward(vertexCount);
+    auto later = [&](uint32_t a, uint32_t b) {
+        return degree[b] > degree[a] || (degree[b] == degree[a] && b > a);
+    };
+    forEachVertex([&](unsigned, uint32_t id) {
+        uint32_t* begin = neighbours.data() + offsets[id];
+        uint32_t* end = std::remove_if(begin, begin + degree[id], [&](uint32_t other) {
+            return !later(id, other);
+        });
+        forward[id] = static_cast<uint32_t>(end - begin);
+    });
+
+    // Every triangle from its first vertex
+    std::unique_ptr<std::atomic<uint64_t>[]> counts(new std::atomic<uint64_t>[vertexCount]);
+    forEachVertex([&](unsigned, uint32_t id) {
+        counts[id].store(0, std::memory_order_relaxed);
+    });
+
+    std::vector<std::vector<uint32_t>> common(threadCount);
+    forEachVertex([&](unsigned thread, uint32_t id) {
+        const uint32_t* mine = neighbours.data() + offsets[id];
+        std::vector<uint32_t>& shared = common[thread];
+        uint64_t own = 0;
+
+        for (uint32_t i = 0; i < forward[id]; i++) {
+            uint32_t other = mine[i];
+            const uint32_t* theirs = neighbours.data() + offsets[other];
+
+            // Common neighbours after other in its own list are after id too
+            shared.resize(std::min(forward[id], forward[other]));
+            size_t found = sortedIntersect(mine, forward[id], theirs, forward[other], shared.data());
+            if (found == 0) {
+                continue;
+            }
+
+            for (size_t k = 0; k < found; k++) {
+                counts[shared[k]].fetch_add(1, std::memory_order_relaxed);
+            }
+            counts[other].fetch_add(found, std::memory_order_relaxed);
+            own += found;
+        }
+
+        if (own != 0) {
+            counts[id].fetch_add(own, std::memory_order_relaxed);
+        }
+    });
+
+    triangles.counts.resize(vertexCount);
+    triangles.clustering.resize(vertexCount);
+    forEachVertex([&](unsigned, uint32_t id) {
+        uint64_t count = counts[id].load(std::memory_order_relaxed);
+        triangles.counts[id] = count;
+
+        uint64_t pairs = degree[id] < 2 ? 0 : uint64_t(degree[id]) * (degree[id] - 1) / 2;
+        triangles.clustering[id] = pairs == 0 ? 0.0 : double(count) / pairs;
+    });
+
+    // Every triangle was counted at each of its three vertices
+    uint64_t sum = 0;
+    for (uint64_t count : triangles.counts) {
+        sum += count;
+    }
+    triangles.triangleCount = sum / 3;
+
+    return 0;
+}
+
+// Triangle counts and clustering coefficients of a Graph. The list-based
+// graph is snapshot to a CsrGraph first, so vertex ID i is the i-th vertex
+// of the graph's adjacency lists, as in CsrGraph.
+template<typename T, typename Compare, typename Hash, typename AdjacentSet>
+int countTriangles(Graph<T, Compare, Hash, AdjacentSet>* graph, Triangles& triangles, ThreadPool& pool) {
+    if (!graph) {
+        return -1;
+    }
+
+    CsrGraph<T> snapshot(*graph);
+    return countTriangles(&snapshot, triangles, pool);
+}
+
+#endif // TRIANGLES_H